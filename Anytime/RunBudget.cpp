@@ -0,0 +1,35 @@
+#include "RunBudget.h"
+
+void RunBudget::start(Stream* stream) {
+    start_time = chrono::steady_clock::now();
+    start_passes = stream->number_of_passes;
+    termination_reason = COMPLETED;
+}
+
+bool RunBudget::isExhausted(Stream* stream, int passes_needed) {
+    if (stop_requested != nullptr && stop_requested->load()) {
+        termination_reason = STOP_REQUESTED;
+        return true;
+    }
+    if (max_passes >= 0 && stream->number_of_passes - start_passes + passes_needed > max_passes) {
+        termination_reason = PASS_LIMIT_REACHED;
+        return true;
+    }
+    if (max_seconds >= 0 && getElapsedSeconds() >= max_seconds) {
+        termination_reason = TIME_LIMIT_REACHED;
+        return true;
+    }
+    return false;
+}
+
+bool RunBudget::isTargetReached(long matching_size, long upper_bound) {
+    if (target_ratio < 0 || matching_size < target_ratio * upper_bound) {
+        return false;
+    }
+    termination_reason = TARGET_RATIO_REACHED;
+    return true;
+}
+
+double RunBudget::getElapsedSeconds() const {
+    return chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+}
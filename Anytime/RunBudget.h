@@ -0,0 +1,42 @@
+#ifndef RUNBUDGET_H
+#define RUNBUDGET_H
+
+#include <atomic>
+#include <chrono>
+
+#include "../Stream/Stream.h"
+
+using namespace std;
+
+enum TerminationReason {
+    COMPLETED = 0, // Every scale was run
+    PASS_LIMIT_REACHED = 1, // Another pass bundle would exceed max_passes
+    TIME_LIMIT_REACHED = 2, // max_seconds have elapsed
+    TARGET_RATIO_REACHED = 3, // The upper bound shows the matching meets target_ratio
+    STOP_REQUESTED = 4, // stop_requested was set, i.e. by a signal handler
+};
+
+// Limits on a run of the algorithm. Each is checked between pass bundles, so a run stops at the first pass bundle
+// boundary after a limit is reached, returning the matching found so far. Negative values disable a limit.
+class RunBudget {
+    // Variables
+    public:
+        int max_passes = -1;
+        double max_seconds = -1;
+        // Fraction of the maximum matching size which is good enough, e.g. 0.95.
+        float target_ratio = -1;
+        atomic<bool>* stop_requested = nullptr;
+        TerminationReason termination_reason = COMPLETED;
+    private:
+        chrono::steady_clock::time_point start_time;
+        int start_passes = 0;
+
+    // Functions
+    public:
+        void start(Stream* stream);
+        bool isExhausted(Stream* stream, int passes_needed);
+        bool isTargetReached(long matching_size, long upper_bound);
+        double getElapsedSeconds() const;
+};
+
+#endif //RUNBUDGET_H
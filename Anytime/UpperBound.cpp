@@ -0,0 +1,40 @@
+#include "UpperBound.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+long getMatchingUpperBound(
+    Stream* stream,
+    Matching* matching
+) {
+    unordered_set<Vertex> free_vertices_with_neighbour;
+    unordered_set<Edge, boost::hash<Edge>> matched_edges_next_to_free;
+    bool is_maximal = true;
+
+    Edge edge = stream->readStream();
+    // edges are only -1 if we have reached the end of the stream.
+    while (edge.first != -1) {
+        // Both arcs of every edge are streamed, so only the first vertex of each arc needs to be considered.
+        if (! matching->isVertexUsedInMatching(edge.first)) {
+            free_vertices_with_neighbour.insert(edge.first);
+
+            if (matching->isVertexUsedInMatching(edge.second)) {
+                matched_edges_next_to_free.insert(matching->getMatchedEdgeFromVertex(edge.second));
+            } else if (edge.first != edge.second) {
+                // An edge between two free vertices is itself an augmenting path.
+                is_maximal = false;
+            }
+        }
+
+        // Reading next edge
+        edge = stream->readStream();
+    }
+
+    long matching_size = matching->matched_edges.size();
+    long augmenting_paths_bound = free_vertices_with_neighbour.size() / 2;
+    if (is_maximal) {
+        augmenting_paths_bound = min(augmenting_paths_bound, static_cast<long>(matched_edges_next_to_free.size()));
+    }
+
+    return matching_size + augmenting_paths_bound;
+}
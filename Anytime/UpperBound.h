@@ -0,0 +1,22 @@
+#ifndef UPPERBOUND_H
+#define UPPERBOUND_H
+
+#include "../types.h"
+#include "../Stream/Stream.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+// Upper bound on the size of a maximum matching, computed in a single pass of the stream using O(n) memory.
+//
+// The symmetric difference of the matching and a maximum matching holds (maximum - |M|) vertex disjoint augmenting
+// paths. Each uses two free vertices with at least one neighbour, and, if the matching is maximal, contains a distinct
+// matched edge with an endpoint adjacent to a free vertex. Hence
+//     maximum <= |M| + min(free vertices with a neighbour / 2, matched edges next to a free vertex).
+// An upper bound equal to |M| proves the matching is maximum.
+long getMatchingUpperBound(
+    Stream* stream,
+    Matching* matching
+);
+
+#endif //UPPERBOUND_H
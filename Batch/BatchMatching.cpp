@@ -0,0 +1,111 @@
+#include "BatchMatching.h"
+
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+#include "../maxMatching.h"
+#include "../Exact/ExactMatchingSolver.h"
+#include "../Stream/EdgeParsing.h"
+#include "../Stream/PermutedStream.h"
+#include "../Structures/Matching.h"
+
+size_t GraphBatch::size() const {
+    return names.size();
+}
+
+GraphBatch readGraphBatch(string file_name) {
+    GraphBatch batch;
+    batch.edge_start.clear();
+    ifstream file = ifstream(file_name);
+
+    string line;
+    while (getline(file, line)) {
+        if (line.compare(0, 8, "# graph ") == 0) {
+            // Edges before the first graph line form their own graph.
+            if (batch.names.empty() && ! batch.edges.empty()) {
+                batch.names.emplace_back("0");
+                batch.edge_start.emplace_back(0);
+            }
+            batch.names.emplace_back(line.substr(8));
+            batch.edge_start.emplace_back(batch.edges.size());
+            continue;
+        }
+
+        // Skipping unimportant lines
+        int v1, v2;
+        if (parseEdgeLine(line.data(), line.data() + line.size(), &v1, &v2)) {
+            batch.edges.emplace_back(v1, v2);
+        }
+    }
+
+    if (batch.names.empty() && ! batch.edges.empty()) {
+        batch.names.emplace_back("0");
+        batch.edge_start.emplace_back(0);
+    }
+    batch.edge_start.emplace_back(batch.edges.size());
+    return batch;
+}
+
+vector<BatchGraphResult> getBatchMatchings(
+    const GraphBatch& batch,
+    float epsilon,
+    Config config,
+    int threads,
+    long exact_edge_limit,
+    bool keep_matchings
+) {
+    // Per graph output would dominate the time taken on small graphs, and tracing, metrics and budgets aren't shared
+    // between threads.
+    config.progress_report = NO_OUTPUT;
+    config.trace_log = nullptr;
+    config.metrics = nullptr;
+    config.budget = nullptr;
+    config.checkpoint = nullptr;
+    config.shared_best = nullptr;
+    config.memory_budget = nullptr;
+
+    vector<BatchGraphResult> results(batch.size());
+    atomic<size_t> next_graph(0);
+
+    vector<thread> workers;
+    for (int i = 0; i < max(1, threads); i++) {
+        workers.emplace_back([&]() {
+            // Reused between graphs, keeping their allocations.
+            ExactMatchingSolver solver;
+            vector<Edge> edges;
+            vector<Edge> matched_edges;
+
+            // Graphs are taken one at a time, so a few large graphs at the start of the batch are spread between the
+            // threads rather than all claimed together. Even the smallest graphs take far longer than the claim.
+            for (size_t graph = next_graph.fetch_add(1); graph < batch.size(); graph = next_graph.fetch_add(1)) {
+                // Self loops can never be matched, and the streaming algorithm assumes there are none.
+                edges.clear();
+                for (size_t i = batch.edge_start[graph]; i < batch.edge_start[graph + 1]; i++) {
+                    if (batch.edges[i].first != batch.edges[i].second) edges.emplace_back(batch.edges[i]);
+                }
+                BatchGraphResult& result = results[graph];
+
+                if (static_cast<long>(edges.size()) <= exact_edge_limit) {
+                    solver.solve(edges, &matched_edges);
+                    result.exact = true;
+                    result.matching_size = matched_edges.size();
+                    if (keep_matchings) result.matched_edges = matched_edges;
+                } else {
+                    PermutedStream stream(&edges, 0);
+                    Matching matching = getMMSSApproxMaximumMatching(&stream, epsilon, config);
+                    result.passes = stream.number_of_passes;
+                    result.matching_size = matching.matched_edges.size();
+                    if (keep_matchings) {
+                        result.matched_edges.assign(matching.matched_edges.begin(), matching.matched_edges.end());
+                    }
+                }
+            }
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    return results;
+}
@@ -0,0 +1,45 @@
+#ifndef BATCHMATCHING_H
+#define BATCHMATCHING_H
+
+#include <string>
+#include <vector>
+
+#include "../types.h"
+
+using namespace std;
+
+// Many small graphs held in a single edge array, graph i being edges [edge_start[i], edge_start[i + 1]).
+struct GraphBatch {
+    vector<string> names;
+    vector<size_t> edge_start = {0};
+    vector<Edge> edges;
+
+    size_t size() const;
+};
+
+struct BatchGraphResult {
+    long matching_size = 0;
+    int passes = 0;
+    // Whether the graph was small enough to be solved exactly.
+    bool exact = false;
+    // Only filled in if the matchings are kept.
+    vector<Edge> matched_edges;
+};
+
+// Reads a file of concatenated graphs, each starting with a line "# graph NAME" followed by a line "u v" per edge.
+// Other lines starting with '#' are comments, and edges before the first graph line form a graph named "0".
+GraphBatch readGraphBatch(string file_name);
+
+// Finds a matching for every graph of the batch, spreading the graphs over the given number of threads. Graphs with at
+// most exact_edge_limit edges are solved exactly in memory, the rest by the MMSS algorithm with the given config.
+// Each thread reuses its buffers and exact solver between graphs, and progress output is disabled.
+vector<BatchGraphResult> getBatchMatchings(
+    const GraphBatch& batch,
+    float epsilon,
+    Config config,
+    int threads,
+    long exact_edge_limit = 4096,
+    bool keep_matchings = false
+);
+
+#endif //BATCHMATCHING_H
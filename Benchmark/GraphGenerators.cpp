@@ -0,0 +1,153 @@
+#include "GraphGenerators.h"
+
+#include <algorithm>
+#include <random>
+
+vector<Edge> generateErdosRenyi(int number_of_vertices, long number_of_edges, uint64_t seed) {
+    mt19937_64 generator(seed);
+    uniform_int_distribution<Vertex> vertex_distribution(0, number_of_vertices - 1);
+
+    vector<Edge> edges;
+    edges.reserve(number_of_edges);
+    while (static_cast<long>(edges.size()) < number_of_edges) {
+        Vertex u = vertex_distribution(generator);
+        Vertex v = vertex_distribution(generator);
+        if (u != v) edges.emplace_back(u, v);
+    }
+    return edges;
+}
+
+vector<Edge> generateRMAT(int scale, long number_of_edges, uint64_t seed) {
+    // Probabilities of recursing into the top left, top right and bottom left quadrants respectively.
+    const double a = 0.57, b = 0.19, c = 0.19;
+
+    mt19937_64 generator(seed);
+    uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    vector<Edge> edges;
+    edges.reserve(number_of_edges);
+    while (static_cast<long>(edges.size()) < number_of_edges) {
+        Vertex u = 0, v = 0;
+        for (int bit = scale - 1; bit >= 0; bit--) {
+            double r = distribution(generator);
+            if (r < a) {
+                continue;
+            } else if (r < a + b) {
+                v |= (1 << bit);
+            } else if (r < a + b + c) {
+                u |= (1 << bit);
+            } else {
+                u |= (1 << bit);
+                v |= (1 << bit);
+            }
+        }
+        if (u != v) edges.emplace_back(u, v);
+    }
+    return edges;
+}
+
+vector<Edge> generateRandomRegular(int number_of_vertices, int degree, uint64_t seed) {
+    mt19937_64 generator(seed);
+
+    vector<Vertex> stubs;
+    stubs.reserve(static_cast<size_t>(number_of_vertices) * degree);
+    for (Vertex vertex = 0; vertex < number_of_vertices; vertex++) {
+        for (int i = 0; i < degree; i++) stubs.emplace_back(vertex);
+    }
+    shuffle(stubs.begin(), stubs.end(), generator);
+
+    vector<Edge> edges;
+    edges.reserve(stubs.size() / 2);
+    for (size_t i = 0; i + 1 < stubs.size(); i += 2) {
+        if (stubs[i] != stubs[i + 1]) edges.emplace_back(stubs[i], stubs[i + 1]);
+    }
+    return edges;
+}
+
+vector<Edge> generateBipartite(int left_size, int right_size, long number_of_edges, uint64_t seed) {
+    mt19937_64 generator(seed);
+    uniform_int_distribution<Vertex> left_distribution(0, left_size - 1);
+    uniform_int_distribution<Vertex> right_distribution(left_size, left_size + right_size - 1);
+
+    vector<Edge> edges;
+    edges.reserve(number_of_edges);
+    for (long i = 0; i < number_of_edges; i++) {
+        edges.emplace_back(left_distribution(generator), right_distribution(generator));
+    }
+    return edges;
+}
+
+vector<Edge> generateGrid(int rows, int columns) {
+    vector<Edge> edges;
+    edges.reserve(2L * rows * columns);
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            Vertex vertex = row * columns + column;
+            if (column + 1 < columns) edges.emplace_back(vertex, vertex + 1);
+            if (row + 1 < rows) edges.emplace_back(vertex, vertex + columns);
+        }
+    }
+    return edges;
+}
+
+vector<Edge> generateLongAugmentingPaths(int number_of_paths, int path_length) {
+    vector<Edge> matched_edges, unmatched_edges;
+
+    int vertices_per_path = 2 * path_length + 2;
+    for (int path = 0; path < number_of_paths; path++) {
+        Vertex first = path * vertices_per_path;
+        for (int i = 0; i < vertices_per_path - 1; i++) {
+            // Odd edges along the path are those we want the greedy matching to take.
+            if (i % 2 == 1) matched_edges.emplace_back(first + i, first + i + 1);
+            else unmatched_edges.emplace_back(first + i, first + i + 1);
+        }
+    }
+
+    matched_edges.insert(matched_edges.end(), unmatched_edges.begin(), unmatched_edges.end());
+    return matched_edges;
+}
+
+// Builds a blossom of the given depth from new vertices, returning its base and one of its innermost vertices.
+static Edge buildNestedBlossom(
+    int depth,
+    Vertex* next_vertex,
+    vector<Edge>* matched_edges,
+    vector<Edge>* unmatched_edges
+) {
+    if (depth == 0) {
+        Vertex vertex = (*next_vertex)++;
+        return make_pair(vertex, vertex);
+    }
+
+    // A blossom is made of three sub-blossoms, the bases of the second and third are matched with each other, and
+    // both are connected to the base of the first, which becomes the base of the whole blossom.
+    Edge first = buildNestedBlossom(depth - 1, next_vertex, matched_edges, unmatched_edges);
+    Edge second = buildNestedBlossom(depth - 1, next_vertex, matched_edges, unmatched_edges);
+    Edge third = buildNestedBlossom(depth - 1, next_vertex, matched_edges, unmatched_edges);
+
+    matched_edges->emplace_back(second.first, third.first);
+    unmatched_edges->emplace_back(first.first, second.first);
+    unmatched_edges->emplace_back(first.first, third.first);
+
+    return make_pair(first.first, second.second);
+}
+
+vector<Edge> generateDeepBlossoms(int number_of_pairs, int depth) {
+    vector<Edge> matched_edges, unmatched_edges;
+    Vertex next_vertex = 0;
+
+    for (int pair = 0; pair < number_of_pairs; pair++) {
+        Edge blossom_x = buildNestedBlossom(depth, &next_vertex, &matched_edges, &unmatched_edges);
+        Edge blossom_y = buildNestedBlossom(depth, &next_vertex, &matched_edges, &unmatched_edges);
+
+        // Joining the innermost vertices of the two blossoms through a matched edge.
+        Vertex x = next_vertex++;
+        Vertex y = next_vertex++;
+        matched_edges.emplace_back(x, y);
+        unmatched_edges.emplace_back(blossom_x.second, x);
+        unmatched_edges.emplace_back(y, blossom_y.second);
+    }
+
+    matched_edges.insert(matched_edges.end(), unmatched_edges.begin(), unmatched_edges.end());
+    return matched_edges;
+}
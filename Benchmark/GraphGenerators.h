@@ -0,0 +1,37 @@
+#ifndef GRAPHGENERATORS_H
+#define GRAPHGENERATORS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../types.h"
+
+using namespace std;
+
+// Each generator returns an edge list, in the order it will be streamed. Self-loops are never produced, but the
+// random generators may produce a small number of duplicate edges, as removing them would require storing a set
+// of every edge generated.
+
+vector<Edge> generateErdosRenyi(int number_of_vertices, long number_of_edges, uint64_t seed);
+
+// R-MAT (recursive matrix) power-law graph on 2^scale vertices, using the standard Graph500 probabilities.
+vector<Edge> generateRMAT(int scale, long number_of_edges, uint64_t seed);
+
+// Random regular graph using the configuration model, pairs of stubs producing self-loops are dropped.
+vector<Edge> generateRandomRegular(int number_of_vertices, int degree, uint64_t seed);
+
+// Random bipartite graph with vertices [0, left_size) on the left and [left_size, left_size + right_size) on the right.
+vector<Edge> generateBipartite(int left_size, int right_size, long number_of_edges, uint64_t seed);
+
+vector<Edge> generateGrid(int rows, int columns);
+
+// Disjoint paths with 2 * path_length + 1 edges each. The middle edges are streamed first so the greedy matching picks
+// them, leaving a single augmenting path of maximum length along each path.
+vector<Edge> generateLongAugmentingPaths(int number_of_paths, int path_length);
+
+// Pairs of recursively nested blossoms of the given depth (3^depth vertices each), in which all vertices other than
+// the base are matched by the greedy matching. The only augmenting path of each pair runs from one base, through every
+// level of nesting, across a matched edge between the two innermost vertices and back out to the other base.
+vector<Edge> generateDeepBlossoms(int number_of_pairs, int depth);
+
+#endif //GRAPHGENERATORS_H
@@ -0,0 +1,359 @@
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "GraphGenerators.h"
+
+#include "../maxMatching.h"
+#include "../types.h"
+#include "../Exact/ExactMatchingSolver.h"
+#include "../Metrics/Metrics.h"
+#include "../Stream/StreamFromMemory.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+struct BenchmarkResult {
+    long matching_size = 0;
+    int passes = 0;
+    double wall_time_ms = 0;
+    long peak_rss_kb = 0;
+};
+
+static void printUsage() {
+    std::cerr << "Usage: MaximumMatchingsBenchmark [options]\n"
+        << "  --generator NAME     er, rmat, regular, bipartite, grid, paths or blossoms (default er)\n"
+        << "  --input FILE         benchmark an edge list file instead of a generated graph\n"
+        << "  --edges N            approximate number of edges to generate (default 10000)\n"
+        << "  --seed N             seed for the random generators (default 1)\n"
+        << "  --epsilon LIST       comma separated epsilon values (default 0.5,0.25)\n"
+        << "  --optimisation LIST  comma separated optimisation levels (default 0,3)\n"
+        << "  --initialiser LIST   comma separated initial matchings, greedy, degree or karp-sipser, each optionally\n"
+        << "                       followed by +aug3 for two rounds of length 3 augmentations (default greedy)\n"
+        << "  --output FILE        write the CSV results to FILE rather than stdout\n"
+        << "  --no-isolate         run every measurement in this process, peak RSS is then cumulative\n"
+        << "  --compare            compare the matching after each scale against the exact maximum matching\n";
+}
+
+static vector<string> splitList(string list) {
+    vector<string> items;
+    stringstream stream(list);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) items.emplace_back(item);
+    }
+    return items;
+}
+
+static void setInitialiser(Config* config, string initialiser) {
+    // Parses an initialiser name, i.e. "karp-sipser+aug3".
+    string suffix = "+aug3";
+    config->length_three_augmentation_rounds = 0;
+    if (initialiser.size() > suffix.size() && initialiser.compare(initialiser.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        config->length_three_augmentation_rounds = 2;
+        initialiser = initialiser.substr(0, initialiser.size() - suffix.size());
+    }
+
+    if (initialiser == "greedy") config->initial_matching = GREEDY;
+    else if (initialiser == "degree") config->initial_matching = DEGREE_AWARE_GREEDY;
+    else if (initialiser == "karp-sipser") config->initial_matching = KARP_SIPSER;
+    else {
+        std::cerr << "Unknown initialiser: " << initialiser << '\n';
+        exit(1);
+    }
+}
+
+static long getPeakRSS() {
+    // ru_maxrss is reported in kilobytes on Linux.
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static vector<Edge> generateGraph(string generator, long number_of_edges, uint64_t seed) {
+    if (generator == "er") {
+        // Average degree of 8.
+        return generateErdosRenyi(max(2L, number_of_edges / 4), number_of_edges, seed);
+    }
+    if (generator == "rmat") {
+        int scale = max(1, static_cast<int>(ceil(log2(max(2.0, number_of_edges / 8.0)))));
+        return generateRMAT(scale, number_of_edges, seed);
+    }
+    if (generator == "regular") {
+        int degree = 4;
+        return generateRandomRegular(max(2L, 2 * number_of_edges / degree), degree, seed);
+    }
+    if (generator == "bipartite") {
+        int side = max(1L, number_of_edges / 8);
+        return generateBipartite(side, side, number_of_edges, seed);
+    }
+    if (generator == "grid") {
+        int side = max(2, static_cast<int>(sqrt(number_of_edges / 2.0)));
+        return generateGrid(side, side);
+    }
+    if (generator == "paths") {
+        int path_length = 50;
+        return generateLongAugmentingPaths(max(1L, number_of_edges / (2 * path_length + 1)), path_length);
+    }
+    if (generator == "blossoms") {
+        // A blossom of depth d has (3^(d+1) - 3) / 2 edges, and each pair adds 3 more, giving 3^(d+1) per pair.
+        int depth = 5;
+        long edges_per_pair = static_cast<long>(pow(3, depth + 1));
+        return generateDeepBlossoms(max(1L, number_of_edges / edges_per_pair), depth);
+    }
+
+    std::cerr << "Unknown generator: " << generator << '\n';
+    exit(1);
+}
+
+static BenchmarkResult runMeasurement(function<BenchmarkResult()> measurement, bool isolate) {
+    if (!isolate) {
+        BenchmarkResult result = measurement();
+        result.peak_rss_kb = getPeakRSS();
+        return result;
+    }
+
+    // Running the measurement in a child process, so the peak RSS reported belongs to this measurement alone.
+    int result_pipe[2];
+    if (pipe(result_pipe) != 0) {
+        std::cerr << "Unable to create pipe for benchmark process" << '\n';
+        exit(1);
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(result_pipe[0]);
+        BenchmarkResult result = measurement();
+        result.peak_rss_kb = getPeakRSS();
+        ssize_t written = write(result_pipe[1], &result, sizeof(BenchmarkResult));
+        _exit(written == sizeof(BenchmarkResult) ? 0 : 1);
+    }
+
+    close(result_pipe[1]);
+    BenchmarkResult result;
+    ssize_t bytes_read = read(result_pipe[0], &result, sizeof(BenchmarkResult));
+    close(result_pipe[0]);
+    waitpid(pid, nullptr, 0);
+
+    if (bytes_read != sizeof(BenchmarkResult)) {
+        std::cerr << "Benchmark process failed" << '\n';
+        exit(1);
+    }
+    return result;
+}
+
+static double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static void runComparison(
+    string graph_name,
+    function<Stream*()> createStream,
+    vector<string> epsilons,
+    vector<string> optimisation_levels,
+    vector<string> initialisers,
+    ostream& output
+) {
+    /* Reports the approximation ratio reached after the initial matching and after each scale, against the passes
+       used so far, so the cheapest epsilon and optimisation level meeting a quality target can be chosen. */
+    ExactMatchingSolver solver;
+
+    Stream* stream = createStream();
+    vector<Edge> edges;
+    Edge edge = stream->readStream();
+    while (edge.first != -1) {
+        if (edge.first < edge.second) edges.emplace_back(edge);
+        edge = stream->readStream();
+    }
+    delete stream;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool bipartite = solver.isBipartite(edges);
+    Matching optimum = bipartite ? solver.solveBipartite(edges) : solver.solve(edges);
+    double exact_time_ms = millisecondsSince(start);
+    long optimum_size = optimum.matched_edges.size();
+
+    output << "graph,epsilon,optimisation_level,initialiser,stage,cumulative_passes,cumulative_wall_time_ms,matching_size,optimum,ratio\n";
+    output << graph_name << ",,,," << (bipartite ? "exact_hopcroft_karp" : "exact_edmonds") << ",0," << exact_time_ms << ",";
+    output << optimum_size << "," << optimum_size << ",1\n";
+
+    for (string epsilon_text : epsilons) {
+        for (string optimisation_text : optimisation_levels) {
+            for (string initialiser : initialisers) {
+                Metrics metrics;
+                Config config;
+                config.progress_report = NO_OUTPUT;
+                config.optimisation_level = static_cast<OptimisationLevel>(stoi(optimisation_text));
+                config.metrics = &metrics;
+                setInitialiser(&config, initialiser);
+
+                stream = createStream();
+                getMMSSApproxMaximumMatching(stream, stof(epsilon_text), config);
+                delete stream;
+
+                int cumulative_passes = 0;
+                double cumulative_time_ms = 0;
+                for (StageMetrics stage : metrics.stages) {
+                    cumulative_passes += stage.passes;
+                    cumulative_time_ms += stage.wall_time_ms;
+                    double ratio = (optimum_size == 0) ? 1.0 : static_cast<double>(stage.matching_size) / optimum_size;
+
+                    output << graph_name << "," << epsilon_text << "," << optimisation_text << "," << initialiser << ",";
+                    output << stage.name << ",";
+                    output << cumulative_passes << "," << cumulative_time_ms << "," << stage.matching_size << ",";
+                    output << optimum_size << "," << ratio << '\n';
+                }
+                output.flush();
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string generator = "er";
+    string input_file;
+    long number_of_edges = 10000;
+    uint64_t seed = 1;
+    vector<string> epsilons = {"0.5", "0.25"};
+    vector<string> optimisation_levels = {"0", "3"};
+    vector<string> initialisers = {"greedy"};
+    string output_file;
+    bool isolate = true;
+    bool compare = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--generator" && has_value) generator = argv[++i];
+        else if (arg == "--input" && has_value) input_file = argv[++i];
+        else if (arg == "--edges" && has_value) number_of_edges = stol(argv[++i]);
+        else if (arg == "--seed" && has_value) seed = stoull(argv[++i]);
+        else if (arg == "--epsilon" && has_value) epsilons = splitList(argv[++i]);
+        else if (arg == "--optimisation" && has_value) optimisation_levels = splitList(argv[++i]);
+        else if (arg == "--initialiser" && has_value) initialisers = splitList(argv[++i]);
+        else if (arg == "--output" && has_value) output_file = argv[++i];
+        else if (arg == "--no-isolate") isolate = false;
+        else if (arg == "--compare") compare = true;
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    vector<Edge> edges;
+    string graph_name;
+    if (!input_file.empty()) {
+        graph_name = input_file;
+    } else {
+        graph_name = generator;
+        edges = generateGraph(generator, number_of_edges, seed);
+    }
+
+    ofstream output_file_stream;
+    if (!output_file.empty()) output_file_stream = ofstream(output_file);
+    ostream& output = output_file.empty() ? std::cout : output_file_stream;
+
+    // Creates a fresh stream for each measurement so pass counts start at zero.
+    auto createStream = [&]() -> Stream* {
+        if (!input_file.empty()) return new StreamFromMemory(input_file);
+        return new StreamFromMemory(edges);
+    };
+
+    if (compare) {
+        runComparison(graph_name, createStream, epsilons, optimisation_levels, initialisers, output);
+        return 0;
+    }
+
+    Vertex max_vertex = -1;
+    for (Edge edge : edges) max_vertex = max(max_vertex, max(edge.first, edge.second));
+
+    output << "graph,vertices,edges,epsilon,optimisation_level,initialiser,measurement,matching_size,passes,wall_time_ms,peak_rss_kb\n";
+    auto outputResult = [&](string epsilon, string optimisation_level, string initialiser, string measurement, BenchmarkResult result) {
+        output << graph_name << ",";
+        // The size of graphs read from a file isn't known here.
+        if (input_file.empty()) output << (max_vertex + 1) << "," << edges.size() << ",";
+        else output << ",,";
+        output << epsilon << "," << optimisation_level << "," << initialiser << ",";
+        output << measurement << "," << result.matching_size << "," << result.passes << ",";
+        output << result.wall_time_ms << "," << result.peak_rss_kb << '\n';
+        output.flush();
+    };
+
+    for (string initialiser : initialisers) {
+        Config initial_config;
+        initial_config.progress_report = NO_OUTPUT;
+        initial_config.optimisation_level = NO_OPTIMISATION;
+        setInitialiser(&initial_config, initialiser);
+
+        // The initial matching, which doesn't depend on epsilon or the optimisation level.
+        BenchmarkResult initial_result = runMeasurement([&]() {
+            Stream* stream = createStream();
+            BenchmarkResult result;
+
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            Matching matching = getInitialMatching(stream, initial_config);
+            result.wall_time_ms = millisecondsSince(start);
+
+            result.matching_size = matching.matched_edges.size();
+            result.passes = stream->number_of_passes;
+            delete stream;
+            return result;
+        }, isolate);
+        outputResult("", "", initialiser, "getInitialMatching", initial_result);
+
+        for (string epsilon_text : epsilons) {
+            float epsilon = stof(epsilon_text);
+
+            for (string optimisation_text : optimisation_levels) {
+                Config config = initial_config;
+                config.optimisation_level = static_cast<OptimisationLevel>(stoi(optimisation_text));
+
+                // A single phase at the first scale, starting from the initial matching.
+                BenchmarkResult phase_result = runMeasurement([&]() {
+                    Stream* stream = createStream();
+                    BenchmarkResult result;
+                    Matching matching = getInitialMatching(stream, config);
+                    int initial_passes = stream->number_of_passes;
+
+                    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                    vector<AugmentingPath> augmenting_paths = algPhase(stream, &matching, epsilon, 0.5f, config);
+                    matching.augmentMatching(&augmenting_paths);
+                    result.wall_time_ms = millisecondsSince(start);
+
+                    result.matching_size = matching.matched_edges.size();
+                    result.passes = stream->number_of_passes - initial_passes;
+                    delete stream;
+                    return result;
+                }, isolate);
+                outputResult(epsilon_text, optimisation_text, initialiser, "algPhase", phase_result);
+
+                BenchmarkResult full_result = runMeasurement([&]() {
+                    Stream* stream = createStream();
+                    BenchmarkResult result;
+
+                    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                    Matching matching = getMMSSApproxMaximumMatching(stream, epsilon, config);
+                    result.wall_time_ms = millisecondsSince(start);
+
+                    result.matching_size = matching.matched_edges.size();
+                    result.passes = stream->number_of_passes;
+                    delete stream;
+                    return result;
+                }, isolate);
+                outputResult(epsilon_text, optimisation_text, initialiser, "getMMSSApproxMaximumMatching", full_result);
+            }
+        }
+    }
+
+    return 0;
+}
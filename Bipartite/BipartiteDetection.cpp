@@ -0,0 +1,64 @@
+#include "BipartiteDetection.h"
+
+#include <unordered_map>
+#include <vector>
+
+// Parent of each vertex in the union-find, along with the parity of the vertex relative to that parent.
+typedef unordered_map<Vertex, pair<Vertex, bool>> ParityForest;
+
+static pair<Vertex, bool> findRoot(ParityForest* forest, Vertex vertex) {
+    /* Returns the root of the vertex's set and the parity of the vertex relative to it, compressing the path. */
+    auto found = forest->find(vertex);
+    if (found == forest->end()) {
+        (*forest)[vertex] = make_pair(vertex, false);
+        return make_pair(vertex, false);
+    }
+
+    // Walking up to the root, accumulating the parity of the vertex relative to it.
+    vector<Vertex> path;
+    Vertex root = vertex;
+    bool parity = false;
+    while ((*forest)[root].first != root) {
+        path.emplace_back(root);
+        parity = parity != (*forest)[root].second;
+        root = (*forest)[root].first;
+    }
+
+    // Pointing every vertex on the path directly at the root, with its parity relative to the root.
+    bool parity_of_current = parity;
+    for (Vertex on_path : path) {
+        bool parity_to_parent = (*forest)[on_path].second;
+        (*forest)[on_path] = make_pair(root, parity_of_current);
+        parity_of_current = parity_of_current != parity_to_parent;
+    }
+
+    return make_pair(root, parity);
+}
+
+bool isStreamBipartite(
+    Stream* stream
+) {
+    ParityForest forest;
+    bool bipartite = true;
+
+    Edge edge = stream->readStream();
+    // edges are only -1 if we have reached the end of the stream. The pass is always finished, so the stream is left
+    // at the start of the next pass.
+    while (edge.first != -1) {
+        if (bipartite) {
+            pair<Vertex, bool> root_of_u = findRoot(&forest, edge.first);
+            pair<Vertex, bool> root_of_v = findRoot(&forest, edge.second);
+
+            if (root_of_u.first == root_of_v.first) {
+                if (root_of_u.second == root_of_v.second) bipartite = false;
+            } else {
+                // Joining the sets so that u and v have different parities.
+                forest[root_of_u.first] = make_pair(root_of_v.first, root_of_u.second == root_of_v.second);
+            }
+        }
+        // Reading next edge
+        edge = stream->readStream();
+    }
+
+    return bipartite;
+}
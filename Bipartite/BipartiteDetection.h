@@ -0,0 +1,16 @@
+#ifndef BIPARTITEDETECTION_H
+#define BIPARTITEDETECTION_H
+
+#include "../types.h"
+#include "../Stream/Stream.h"
+
+using namespace std;
+
+// Checks whether the graph is bipartite in a single pass using O(n) memory. A union-find over the vertices stores the
+// parity of each vertex relative to its parent, and an edge between two vertices of the same set with equal parity
+// closes an odd cycle.
+bool isStreamBipartite(
+    Stream* stream
+);
+
+#endif //BIPARTITEDETECTION_H
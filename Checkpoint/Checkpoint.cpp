@@ -0,0 +1,118 @@
+#include "Checkpoint.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+// Fixed size header at the start of the checkpoint file.
+struct CheckpointHeader {
+    uint32_t magic;
+    uint32_t version;
+    float epsilon;
+    int32_t scale_index;
+    int32_t phase;
+    int32_t number_of_passes;
+    int32_t number_of_vertices;
+    int32_t padding;
+};
+
+static bool writeAll(int fd, const char* data, size_t bytes_left) {
+    while (bytes_left > 0) {
+        ssize_t bytes_written = write(fd, data, bytes_left);
+        if (bytes_written < 0 && errno == EINTR) continue;
+        if (bytes_written <= 0) return false;
+        data += bytes_written;
+        bytes_left -= bytes_written;
+    }
+    return true;
+}
+
+Checkpoint::Checkpoint(string file_name, double interval_seconds) {
+    this->file_name = file_name;
+    this->interval_seconds = interval_seconds;
+    last_write_time = chrono::steady_clock::now();
+}
+
+bool Checkpoint::isDue() const {
+    return chrono::duration<double>(chrono::steady_clock::now() - last_write_time).count() >= interval_seconds;
+}
+
+bool Checkpoint::write(Matching* matching, float epsilon, int scale_index, int phase, int number_of_passes) {
+    last_write_time = chrono::steady_clock::now();
+
+    // Building the dense mate array, reusing the buffer between checkpoints.
+    int number_of_vertices = 0;
+    for (Edge edge : matching->matched_edges) {
+        number_of_vertices = max(number_of_vertices, max(edge.first, edge.second) + 1);
+    }
+    mate_buffer.assign(number_of_vertices, -1);
+    for (Edge edge : matching->matched_edges) {
+        mate_buffer[edge.first] = edge.second;
+        mate_buffer[edge.second] = edge.first;
+    }
+
+    CheckpointHeader header = {MAGIC, VERSION, epsilon, scale_index, phase, number_of_passes, number_of_vertices, 0};
+
+    // The temporary file is flushed to disk before it replaces the last checkpoint, so a crash never leaves a
+    // truncated checkpoint behind.
+    string temporary_file_name = file_name + ".tmp";
+    int fd = open(temporary_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool written = fd != -1;
+    written = written && writeAll(fd, reinterpret_cast<const char*>(&header), sizeof(header));
+    written = written && writeAll(fd, reinterpret_cast<const char*>(mate_buffer.data()), mate_buffer.size() * sizeof(int32_t));
+    written = written && fsync(fd) == 0;
+    if (fd != -1 && close(fd) != 0) written = false;
+
+    if (!written || rename(temporary_file_name.c_str(), file_name.c_str()) != 0) {
+        std::cerr << "Unable to write checkpoint " << file_name << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool Checkpoint::read(string file_name, CheckpointState* state) {
+    ifstream file(file_name, ios::binary);
+    CheckpointHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != MAGIC || header.version != VERSION || header.number_of_vertices < 0) {
+        std::cerr << "Unable to read checkpoint " << file_name << '\n';
+        return false;
+    }
+
+    vector<int32_t> mate(header.number_of_vertices);
+    file.read(reinterpret_cast<char*>(mate.data()), mate.size() * sizeof(int32_t));
+    if (!file) {
+        std::cerr << "Checkpoint " << file_name << " is truncated" << '\n';
+        return false;
+    }
+
+    state->epsilon = header.epsilon;
+    state->scale_index = header.scale_index;
+    state->phase = header.phase;
+    state->number_of_passes = header.number_of_passes;
+    state->matching = Matching();
+    for (int vertex = 0; vertex < header.number_of_vertices; vertex++) {
+        if (mate[vertex] > vertex) {
+            state->matching.addEdge(make_pair(vertex, mate[vertex]));
+        }
+    }
+    return true;
+}
+
+bool saveMatching(string file_name, Matching* matching) {
+    Checkpoint checkpoint(file_name);
+    return checkpoint.write(matching, 0, 0, 1, 0);
+}
+
+bool loadMatching(string file_name, Matching* matching) {
+    CheckpointState state;
+    if (!Checkpoint::read(file_name, &state)) {
+        return false;
+    }
+    *matching = state.matching;
+    return true;
+}
@@ -0,0 +1,51 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../types.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+// Position of a run of the MMSS algorithm, enough to resume it from the start of a phase.
+struct CheckpointState {
+    float epsilon = 0;
+    int scale_index = 0;
+    // The next phase to run within the scale.
+    int phase = 1;
+    int number_of_passes = 0;
+    Matching matching;
+};
+
+// Periodically saves the matching and position of a run to a binary file. The file holds a small header followed by
+// a dense mate array, where entry v is the vertex matched to v or -1, so writing it is a single sequential write.
+// The file is written to a temporary path then renamed, so an interrupted write never replaces a good checkpoint.
+class Checkpoint {
+    // Variables
+    public:
+        string file_name;
+        double interval_seconds;
+    private:
+        static const uint32_t MAGIC = 0x4b434d4d; // "MMCK"
+        static const uint32_t VERSION = 1;
+
+        chrono::steady_clock::time_point last_write_time;
+        vector<int32_t> mate_buffer;
+
+    // Functions
+    public:
+        explicit Checkpoint(string file_name, double interval_seconds = 300);
+        bool isDue() const;
+        bool write(Matching* matching, float epsilon, int scale_index, int phase, int number_of_passes);
+        static bool read(string file_name, CheckpointState* state);
+};
+
+// Saves a finished matching in the checkpoint format, so it can be used to warm start a later run.
+bool saveMatching(string file_name, Matching* matching);
+bool loadMatching(string file_name, Matching* matching);
+
+#endif //CHECKPOINT_H
@@ -0,0 +1,176 @@
+#include "DynamicMatching.h"
+
+#include <chrono>
+
+#include "../maxMatching.h"
+#include "../Stream/StreamFromMemory.h"
+
+DynamicMatching::DynamicMatching(float epsilon, Config config, int refresh_interval) {
+    this->epsilon = epsilon;
+    this->refresh_interval = refresh_interval;
+    this->config = config;
+    // Budgets and checkpoints belong to a single run, so aren't used for the local phases or refreshes.
+    this->config.budget = nullptr;
+    this->config.checkpoint = nullptr;
+}
+
+bool DynamicMatching::insertEdge(Edge edge) {
+    if (edge.first == edge.second) return false;
+    if (!adjacency[edge.first].insert(edge.second).second) return false;
+    adjacency[edge.second].insert(edge.first);
+    number_of_edges += 1;
+    return true;
+}
+
+bool DynamicMatching::deleteEdge(Edge edge) {
+    auto neighbours_of_u = adjacency.find(edge.first);
+    if (neighbours_of_u == adjacency.end() || neighbours_of_u->second.erase(edge.second) == 0) return false;
+    if (neighbours_of_u->second.empty()) adjacency.erase(neighbours_of_u);
+
+    auto neighbours_of_v = adjacency.find(edge.second);
+    neighbours_of_v->second.erase(edge.first);
+    if (neighbours_of_v->second.empty()) adjacency.erase(neighbours_of_v);
+
+    number_of_edges -= 1;
+    return true;
+}
+
+bool DynamicMatching::matchGreedily(Vertex vertex) {
+    if (matching.isVertexUsedInMatching(vertex)) return false;
+
+    auto neighbours = adjacency.find(vertex);
+    if (neighbours == adjacency.end()) return false;
+
+    for (Vertex neighbour : neighbours->second) {
+        if (! matching.isVertexUsedInMatching(neighbour)) {
+            matching.addEdge(make_pair(vertex, neighbour));
+            return true;
+        }
+    }
+    return false;
+}
+
+vector<Edge> DynamicMatching::getNeighbourhood(const vector<Vertex>& roots, Matching* local_matching) {
+    /* Breadth first search from the roots, stopping once local_search_limit vertices have been reached. The mate of
+       each matched vertex reached is always included, so a vertex is free in the local matching only if it is free in
+       the whole matching. */
+    unordered_set<Vertex> reached;
+    vector<Vertex> queue;
+
+    auto reach = [&](Vertex vertex) {
+        if (!reached.insert(vertex).second) return;
+        queue.emplace_back(vertex);
+        if (matching.isVertexUsedInMatching(vertex)) {
+            Edge matched_edge = matching.getMatchedEdgeFromVertex(vertex);
+            Vertex mate = (matched_edge.first == vertex) ? matched_edge.second : matched_edge.first;
+            if (reached.insert(mate).second) queue.emplace_back(mate);
+            local_matching->addEdge(matched_edge);
+        }
+    };
+
+    for (Vertex root : roots) reach(root);
+    for (size_t head = 0; head < queue.size() && reached.size() < local_search_limit; head++) {
+        auto neighbours = adjacency.find(queue[head]);
+        if (neighbours == adjacency.end()) continue;
+        for (Vertex neighbour : neighbours->second) {
+            if (reached.size() >= local_search_limit) break;
+            reach(neighbour);
+        }
+    }
+
+    // Every edge between two reached vertices, each edge once.
+    vector<Edge> edges;
+    for (Vertex vertex : queue) {
+        auto neighbours = adjacency.find(vertex);
+        if (neighbours == adjacency.end()) continue;
+        for (Vertex neighbour : neighbours->second) {
+            if (vertex < neighbour && reached.count(neighbour)) edges.emplace_back(vertex, neighbour);
+        }
+    }
+    return edges;
+}
+
+long DynamicMatching::augmentLocally(const vector<Vertex>& free_vertices) {
+    /* Runs phases of the MMSS algorithm on the neighbourhood of the free vertices, using a matching restricted to the
+       neighbourhood so the cost depends on its size rather than the size of the whole graph. */
+    Matching local_matching;
+    vector<Edge> local_edges = getNeighbourhood(free_vertices, &local_matching);
+    if (local_edges.empty()) return 0;
+
+    StreamFromMemory local_stream(local_edges);
+    long augmentations = 0;
+    for (int phase = 0; phase < local_phases; phase++) {
+        vector<AugmentingPath> disjoint_augmenting_paths = algPhase(&local_stream, &local_matching, epsilon, local_scale, config);
+        if (disjoint_augmenting_paths.empty()) break;
+
+        local_matching.augmentMatching(&disjoint_augmenting_paths);
+        matching.augmentMatching(&disjoint_augmenting_paths);
+        augmentations += disjoint_augmenting_paths.size();
+    }
+    return augmentations;
+}
+
+DynamicUpdateStats DynamicMatching::applyUpdates(const vector<Edge>& insertions, const vector<Edge>& deletions) {
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    DynamicUpdateStats stats;
+
+    // Vertices which may have become free, or gained a free neighbour, in this batch.
+    vector<Vertex> affected;
+
+    for (Edge edge : deletions) {
+        if (!deleteEdge(edge)) continue;
+        stats.edges_deleted += 1;
+
+        if (matching.isInMatching(edge)) {
+            matching.removeEdgeAndItsVertices(edge);
+            stats.matched_edges_deleted += 1;
+            affected.emplace_back(edge.first);
+            affected.emplace_back(edge.second);
+        }
+    }
+
+    for (Edge edge : insertions) {
+        if (!insertEdge(edge)) continue;
+        stats.edges_inserted += 1;
+        affected.emplace_back(edge.first);
+        affected.emplace_back(edge.second);
+    }
+
+    // Greedily matching the affected vertices, then searching for augmenting paths from any left free.
+    vector<Vertex> free_vertices;
+    for (Vertex vertex : affected) {
+        if (matchGreedily(vertex)) stats.greedy_matches += 1;
+        else if (! matching.isVertexUsedInMatching(vertex) && adjacency.count(vertex)) free_vertices.emplace_back(vertex);
+    }
+    if (!free_vertices.empty()) stats.augmentations = augmentLocally(free_vertices);
+
+    batches_since_refresh += 1;
+    if (refresh_interval > 0 && batches_since_refresh >= refresh_interval) {
+        refresh();
+        stats.refreshed = true;
+    }
+
+    stats.wall_time_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start_time).count();
+    return stats;
+}
+
+void DynamicMatching::refresh() {
+    batches_since_refresh = 0;
+    StreamFromMemory stream(getEdges());
+    matching = warmStartMMSSApproxMaximumMatching(&stream, epsilon, &matching, 0, config);
+}
+
+long DynamicMatching::getNumberOfEdges() const {
+    return number_of_edges;
+}
+
+vector<Edge> DynamicMatching::getEdges() const {
+    vector<Edge> edges;
+    edges.reserve(number_of_edges);
+    for (const pair<const Vertex, unordered_set<Vertex>>& vertex : adjacency) {
+        for (Vertex neighbour : vertex.second) {
+            if (vertex.first < neighbour) edges.emplace_back(vertex.first, neighbour);
+        }
+    }
+    return edges;
+}
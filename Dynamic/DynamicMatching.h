@@ -0,0 +1,63 @@
+#ifndef DYNAMICMATCHING_H
+#define DYNAMICMATCHING_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../types.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+// Summary of a single batch of updates.
+struct DynamicUpdateStats {
+    long edges_inserted = 0;
+    long edges_deleted = 0;
+    // Deleted edges which were in the matching.
+    long matched_edges_deleted = 0;
+    long greedy_matches = 0;
+    long augmentations = 0;
+    bool refreshed = false;
+    double wall_time_ms = 0;
+};
+
+// Maintains an approximate maximum matching of a graph which changes by batches of edge insertions and deletions.
+// Each batch is repaired locally: deleted matched edges are unmatched, freed vertices are greedily matched, and the
+// existing MMSS phase is run on the neighbourhood of any vertices left free to find short augmenting paths. Every
+// refresh_interval batches the whole graph is improved by a full MMSS run, warm started from the current matching.
+class DynamicMatching {
+    // Variables
+    public:
+        Matching matching;
+        float epsilon;
+        // Number of batches between full refreshes, 0 disables refreshes.
+        int refresh_interval;
+        // Maximum number of vertices in the neighbourhood searched for augmenting paths after each batch.
+        size_t local_search_limit = 4096;
+        // Maximum number of phases run on the neighbourhood after each batch.
+        int local_phases = 4;
+        // Scale of the local phases, the augmenting paths found have at most 6 / local_scale + 1 edges.
+        float local_scale = 0.5f;
+    private:
+        Config config;
+        unordered_map<Vertex, unordered_set<Vertex>> adjacency;
+        long number_of_edges = 0;
+        int batches_since_refresh = 0;
+
+    // Functions
+    public:
+        DynamicMatching(float epsilon, Config config, int refresh_interval = 100);
+        DynamicUpdateStats applyUpdates(const vector<Edge>& insertions, const vector<Edge>& deletions);
+        void refresh();
+        long getNumberOfEdges() const;
+        vector<Edge> getEdges() const;
+    private:
+        bool insertEdge(Edge edge);
+        bool deleteEdge(Edge edge);
+        bool matchGreedily(Vertex vertex);
+        long augmentLocally(const vector<Vertex>& free_vertices);
+        vector<Edge> getNeighbourhood(const vector<Vertex>& roots, Matching* local_matching);
+};
+
+#endif //DYNAMICMATCHING_H
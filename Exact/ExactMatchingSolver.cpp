@@ -0,0 +1,402 @@
+#include "ExactMatchingSolver.h"
+
+#include <limits>
+
+void ExactMatchingSolver::buildGraph(const vector<Edge>& edges) {
+    // Buffers are cleared rather than recreated, so a solver reused across graphs keeps its allocations.
+    index_to_vertex.clear();
+    vertex_to_index.clear();
+
+    vector<int>& degree = distance;
+    degree.clear();
+
+    for (Edge edge : edges) {
+        if (edge.first == edge.second) continue;
+        for (Vertex vertex : {edge.first, edge.second}) {
+            if (vertex_to_index.find(vertex) == vertex_to_index.end()) {
+                vertex_to_index[vertex] = static_cast<int>(index_to_vertex.size());
+                index_to_vertex.emplace_back(vertex);
+                degree.emplace_back(0);
+            }
+        }
+        degree[vertex_to_index[edge.first]] += 1;
+        degree[vertex_to_index[edge.second]] += 1;
+    }
+
+    int n = static_cast<int>(index_to_vertex.size());
+    adjacency_start.assign(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        adjacency_start[i + 1] = adjacency_start[i] + degree[i];
+    }
+
+    // Reusing the degree array as the insertion position of each vertex.
+    for (int i = 0; i < n; i++) {
+        degree[i] = adjacency_start[i];
+    }
+    adjacency.resize(adjacency_start[n]);
+    for (Edge edge : edges) {
+        if (edge.first == edge.second) continue;
+        int u = vertex_to_index[edge.first];
+        int v = vertex_to_index[edge.second];
+        adjacency[degree[u]++] = v;
+        adjacency[degree[v]++] = u;
+    }
+
+    mate.assign(n, -1);
+    parent.assign(n, -1);
+    blossom_set.resize(n);
+    base.resize(n);
+    for (int i = 0; i < n; i++) {
+        blossom_set[i] = i;
+        base[i] = i;
+    }
+    used.assign(n, 0);
+    ancestor_mark.assign(n, 0);
+    current_mark = 0;
+    touched.clear();
+}
+
+void ExactMatchingSolver::addGreedyMatching() {
+    // Starting from a greedy matching greatly reduces the number of searches required.
+    int n = static_cast<int>(index_to_vertex.size());
+    for (int u = 0; u < n; u++) {
+        if (mate[u] != -1) continue;
+        for (int i = adjacency_start[u]; i < adjacency_start[u + 1]; i++) {
+            int v = adjacency[i];
+            if (mate[v] == -1) {
+                mate[u] = v;
+                mate[v] = u;
+                break;
+            }
+        }
+    }
+}
+
+int ExactMatchingSolver::findSet(int v) {
+    // Union-find over the contracted blossoms, with path halving.
+    while (blossom_set[v] != v) {
+        blossom_set[v] = blossom_set[blossom_set[v]];
+        v = blossom_set[v];
+    }
+    return v;
+}
+
+int ExactMatchingSolver::findBase(int v) {
+    return base[findSet(v)];
+}
+
+void ExactMatchingSolver::mergeIntoBlossom(int v, int blossom_base) {
+    int set_of_v = findSet(v);
+    int set_of_base = findSet(blossom_base);
+    if (set_of_v == set_of_base) return;
+
+    blossom_set[set_of_v] = set_of_base;
+    base[set_of_base] = blossom_base;
+}
+
+int ExactMatchingSolver::lowestCommonAncestor(int a, int b) {
+    current_mark += 1;
+
+    // Marking every base on the path from a to the root of the search tree.
+    while (true) {
+        a = findBase(a);
+        ancestor_mark[a] = current_mark;
+        if (mate[a] == -1) break;
+        a = parent[mate[a]];
+    }
+
+    // The first marked base on the path from b to the root is the lowest common ancestor.
+    while (true) {
+        b = findBase(b);
+        if (ancestor_mark[b] == current_mark) return b;
+        b = parent[mate[b]];
+    }
+}
+
+void ExactMatchingSolver::markPath(int v, int blossom_base, int child) {
+    /* Records the path from v up to the blossom base, pointing the outer vertices on it back along the blossom. The
+       vertices are only merged once both sides have been walked, as merging an earlier blossom part way along the path
+       would end the walk before the base is reached. */
+    while (findBase(v) != blossom_base) {
+        int matched_to = mate[v];
+        parent[v] = child;
+        child = matched_to;
+
+        blossom_vertices.emplace_back(v);
+        blossom_vertices.emplace_back(matched_to);
+
+        v = parent[matched_to];
+    }
+}
+
+int ExactMatchingSolver::findAugmentingPath(int root) {
+    /* Edmonds' blossom algorithm: grows an alternating tree from root, contracting blossoms, until a free vertex is
+       reached. Returns the free vertex found, or -1 if there is no augmenting path from root. */
+
+    // Only resetting the state of vertices touched by the previous search.
+    for (int v : touched) {
+        used[v] = 0;
+        parent[v] = -1;
+        blossom_set[v] = v;
+        base[v] = v;
+    }
+    touched.clear();
+
+    search_queue.clear();
+    used[root] = 1;
+    touched.emplace_back(root);
+    search_queue.emplace_back(root);
+
+    for (size_t head = 0; head < search_queue.size(); head++) {
+        int v = search_queue[head];
+
+        for (int i = adjacency_start[v]; i < adjacency_start[v + 1]; i++) {
+            int to = adjacency[i];
+
+            if (mate[v] == to || findBase(v) == findBase(to)) continue;
+
+            if (to == root || (mate[to] != -1 && parent[mate[to]] != -1)) {
+                // Both endpoints are outer vertices of the tree, so the edge closes a blossom.
+                int blossom_base = lowestCommonAncestor(v, to);
+                blossom_vertices.clear();
+                markPath(v, blossom_base, to);
+                markPath(to, blossom_base, v);
+
+                // The inner vertices of the blossom become outer vertices, so are added to the search queue.
+                for (int vertex : blossom_vertices) {
+                    mergeIntoBlossom(vertex, blossom_base);
+                    if (!used[vertex]) {
+                        used[vertex] = 1;
+                        search_queue.emplace_back(vertex);
+                    }
+                }
+            } else if (parent[to] == -1) {
+                parent[to] = v;
+                touched.emplace_back(to);
+                if (mate[to] == -1) return to;
+
+                int next = mate[to];
+                used[next] = 1;
+                touched.emplace_back(next);
+                search_queue.emplace_back(next);
+            }
+        }
+    }
+
+    return -1;
+}
+
+Matching ExactMatchingSolver::solve(const vector<Edge>& edges, Matching* initial_matching) {
+    findMaximumMatching(edges, initial_matching);
+    return getMatching();
+}
+
+void ExactMatchingSolver::solve(const vector<Edge>& edges, vector<Edge>* matched_edges) {
+    findMaximumMatching(edges, nullptr);
+
+    matched_edges->clear();
+    int n = static_cast<int>(index_to_vertex.size());
+    for (int v = 0; v < n; v++) {
+        if (mate[v] > v) matched_edges->emplace_back(index_to_vertex[v], index_to_vertex[mate[v]]);
+    }
+}
+
+void ExactMatchingSolver::findMaximumMatching(const vector<Edge>& edges, Matching* initial_matching) {
+    buildGraph(edges);
+
+    // Seeding the search with any edges of the initial matching present in the graph.
+    if (initial_matching != nullptr) {
+        for (Edge edge : initial_matching->matched_edges) {
+            if (vertex_to_index.find(edge.first) == vertex_to_index.end()) continue;
+            if (vertex_to_index.find(edge.second) == vertex_to_index.end()) continue;
+
+            int u = vertex_to_index[edge.first];
+            int v = vertex_to_index[edge.second];
+            if (mate[u] == -1 && mate[v] == -1) {
+                mate[u] = v;
+                mate[v] = u;
+            }
+        }
+    }
+    addGreedyMatching();
+
+    // A vertex with no augmenting path never gains one in later iterations, so each free vertex is searched once.
+    int n = static_cast<int>(index_to_vertex.size());
+    for (int root = 0; root < n; root++) {
+        if (mate[root] != -1) continue;
+
+        int v = findAugmentingPath(root);
+
+        // Flipping the matched and unmatched edges along the path back to the root.
+        while (v != -1) {
+            int parent_of_v = parent[v];
+            int next = mate[parent_of_v];
+            mate[v] = parent_of_v;
+            mate[parent_of_v] = v;
+            v = next;
+        }
+    }
+}
+
+Matching ExactMatchingSolver::solve(Stream* stream) {
+    // Both arcs of each edge are streamed, so only the arc with the smaller vertex first is kept.
+    vector<Edge> edges;
+    Edge edge = stream->readStream();
+    while (edge.first != -1) {
+        if (edge.first < edge.second) edges.emplace_back(edge);
+        edge = stream->readStream();
+    }
+
+    return solve(edges);
+}
+
+bool ExactMatchingSolver::colourGraph() {
+    // Two colours the graph using a BFS from each uncoloured vertex.
+    int n = static_cast<int>(index_to_vertex.size());
+    side.assign(n, -1);
+
+    for (int start = 0; start < n; start++) {
+        if (side[start] != -1) continue;
+
+        side[start] = 0;
+        search_queue.clear();
+        search_queue.emplace_back(start);
+        for (size_t head = 0; head < search_queue.size(); head++) {
+            int v = search_queue[head];
+            for (int i = adjacency_start[v]; i < adjacency_start[v + 1]; i++) {
+                int to = adjacency[i];
+                if (side[to] == -1) {
+                    side[to] = 1 - side[v];
+                    search_queue.emplace_back(to);
+                } else if (side[to] == side[v]) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ExactMatchingSolver::isBipartite(const vector<Edge>& edges) {
+    buildGraph(edges);
+    return colourGraph();
+}
+
+bool ExactMatchingSolver::hopcroftKarpLayers() {
+    /* Builds the BFS layers of the left vertices from the free left vertices. Returns whether a free right vertex
+       can be reached. */
+    const int infinity = numeric_limits<int>::max();
+    int n = static_cast<int>(index_to_vertex.size());
+
+    search_queue.clear();
+    for (int v = 0; v < n; v++) {
+        if (side[v] == 0 && mate[v] == -1) {
+            distance[v] = 0;
+            search_queue.emplace_back(v);
+        } else {
+            distance[v] = infinity;
+        }
+    }
+
+    free_layer = infinity;
+    for (size_t head = 0; head < search_queue.size(); head++) {
+        int v = search_queue[head];
+        if (distance[v] >= free_layer) continue;
+
+        for (int i = adjacency_start[v]; i < adjacency_start[v + 1]; i++) {
+            int matched_to = mate[adjacency[i]];
+            if (matched_to == -1) {
+                free_layer = min(free_layer, distance[v]);
+            } else if (distance[matched_to] == infinity) {
+                distance[matched_to] = distance[v] + 1;
+                search_queue.emplace_back(matched_to);
+            }
+        }
+    }
+
+    return free_layer != infinity;
+}
+
+bool ExactMatchingSolver::hopcroftKarpAugment(int vertex) {
+    /* Iterative DFS along the BFS layers from a free left vertex, augmenting along the first path found. */
+    const int infinity = numeric_limits<int>::max();
+    if (distance[vertex] != 0) return false;
+
+    vector<int>& path = search_queue;
+    path.clear();
+    path.emplace_back(vertex);
+
+    while (!path.empty()) {
+        int v = path.back();
+
+        if (next_neighbour[v] == adjacency_start[v + 1]) {
+            // Dead end, removing the vertex from the layers so it isn't explored again this round.
+            distance[v] = infinity;
+            path.pop_back();
+            continue;
+        }
+
+        int to = adjacency[next_neighbour[v]++];
+        int matched_to = mate[to];
+
+        if (matched_to == -1) {
+            if (distance[v] != free_layer) continue;
+
+            // Flipping the path, the left vertex at position i is matched to the right vertex used to reach i + 1.
+            for (size_t i = path.size(); i-- > 0;) {
+                int right = (i + 1 == path.size()) ? to : reached_through[path[i + 1]];
+                mate[path[i]] = right;
+                mate[right] = path[i];
+            }
+            return true;
+        }
+
+        if (distance[matched_to] == distance[v] + 1) {
+            reached_through[matched_to] = to;
+            path.emplace_back(matched_to);
+        }
+    }
+
+    return false;
+}
+
+Matching ExactMatchingSolver::solveBipartite(const vector<Edge>& edges) {
+    buildGraph(edges);
+
+    // Falling back to the general algorithm if the graph turns out not to be bipartite.
+    if (!colourGraph()) {
+        return solve(edges);
+    }
+
+    addGreedyMatching();
+
+    int n = static_cast<int>(index_to_vertex.size());
+    distance.resize(n);
+    next_neighbour.resize(n);
+    reached_through.resize(n);
+
+    while (hopcroftKarpLayers()) {
+        for (int v = 0; v < n; v++) {
+            next_neighbour[v] = adjacency_start[v];
+        }
+        for (int v = 0; v < n; v++) {
+            if (side[v] == 0 && mate[v] == -1) {
+                hopcroftKarpAugment(v);
+            }
+        }
+    }
+
+    return getMatching();
+}
+
+Matching ExactMatchingSolver::getMatching() {
+    Matching matching;
+    int n = static_cast<int>(index_to_vertex.size());
+    for (int v = 0; v < n; v++) {
+        if (mate[v] > v) {
+            matching.addEdge(make_pair(index_to_vertex[v], index_to_vertex[mate[v]]));
+        }
+    }
+    return matching;
+}
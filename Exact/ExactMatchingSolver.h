@@ -0,0 +1,70 @@
+#ifndef EXACTMATCHINGSOLVER_H
+#define EXACTMATCHINGSOLVER_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "../types.h"
+#include "../Stream/Stream.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+// In-memory exact maximum matching, used as a reference for the quality of the streaming algorithm. The whole graph
+// is held in memory, so this is only suitable for graphs which fit comfortably in RAM.
+class ExactMatchingSolver {
+    // Variables
+    private:
+        // Vertices are relabelled to [0, n) so the search can use flat arrays.
+        vector<Vertex> index_to_vertex;
+        unordered_map<Vertex, int> vertex_to_index;
+        // Adjacency lists in compressed sparse row form.
+        vector<int> adjacency_start;
+        vector<int> adjacency;
+        vector<int> mate;
+
+        // Working state of the Edmonds blossom search.
+        vector<int> parent;
+        // Contracted blossoms are held in a union-find, with the base of each blossom stored at its representative.
+        vector<int> blossom_set;
+        vector<int> base;
+        vector<int> search_queue;
+        // Vertices on the two paths closing the blossom being contracted.
+        vector<int> blossom_vertices;
+        vector<int> touched;
+        vector<char> used;
+        vector<int> ancestor_mark;
+        int current_mark = 0;
+
+        // Working state of Hopcroft-Karp.
+        vector<int> side;
+        vector<int> distance;
+        vector<int> next_neighbour;
+        vector<int> reached_through;
+        int free_layer = 0;
+
+    // Functions
+    public:
+        Matching solve(const vector<Edge>& edges, Matching* initial_matching = nullptr);
+        // Writes the matched edges to a list rather than a Matching, for callers solving many graphs.
+        void solve(const vector<Edge>& edges, vector<Edge>* matched_edges);
+        Matching solve(Stream* stream);
+        Matching solveBipartite(const vector<Edge>& edges);
+        bool isBipartite(const vector<Edge>& edges);
+    private:
+        void buildGraph(const vector<Edge>& edges);
+        void findMaximumMatching(const vector<Edge>& edges, Matching* initial_matching);
+        void addGreedyMatching();
+        bool colourGraph();
+        int findSet(int v);
+        int findBase(int v);
+        void mergeIntoBlossom(int v, int blossom_base);
+        int lowestCommonAncestor(int a, int b);
+        void markPath(int v, int blossom_base, int child);
+        int findAugmentingPath(int root);
+        bool hopcroftKarpLayers();
+        bool hopcroftKarpAugment(int vertex);
+        Matching getMatching();
+};
+
+#endif //EXACTMATCHINGSOLVER_H
@@ -0,0 +1,69 @@
+#include "ResidualGraph.h"
+
+#include <unordered_map>
+
+static Vertex getMate(Matching* matching, Vertex vertex) {
+    if (! matching->isVertexUsedInMatching(vertex)) return -1;
+    Edge matched_edge = matching->getMatchedEdgeFromVertex(vertex);
+    return (matched_edge.first == vertex) ? matched_edge.second : matched_edge.first;
+}
+
+bool getResidualGraph(
+    Stream* stream,
+    Matching* matching,
+    int distance,
+    long edge_limit,
+    vector<Edge>* edges,
+    bool* saturated
+) {
+    /* Grows the region around the free vertices by one edge per pass, adding the mate of every vertex reached. Every
+       vertex reached has an edge inside the region, so the region can only fit within the edge limit while it has at
+       most twice as many vertices. */
+    unordered_map<Vertex, int> reached_in_pass;
+    long vertex_limit = 2 * edge_limit;
+    bool over_limit = false;
+    *saturated = false;
+
+    for (int pass = 1; pass <= distance && ! over_limit; pass++) {
+        long reached_before = reached_in_pass.size();
+
+        Edge edge = stream->readStream();
+        while (edge.first != -1) {
+            if (! over_limit) {
+                // Free vertices are found in the first pass, as the start of any arc, even if already reached.
+                if (pass == 1 && ! matching->isVertexUsedInMatching(edge.first)) reached_in_pass[edge.first] = 0;
+
+                unordered_map<Vertex, int>::iterator from = reached_in_pass.find(edge.first);
+                if (from != reached_in_pass.end() && from->second < pass && reached_in_pass.count(edge.second) == 0) {
+                    reached_in_pass.emplace(edge.second, pass);
+                    Vertex mate = getMate(matching, edge.second);
+                    if (mate != -1) reached_in_pass.emplace(mate, pass);
+                }
+                over_limit = static_cast<long>(reached_in_pass.size()) > vertex_limit;
+            }
+            // Reading next edge, the rest of the pass is still read if the limit is passed.
+            edge = stream->readStream();
+        }
+
+        // Once a pass reaches nothing new, the region is closed.
+        if (pass > 1 && static_cast<long>(reached_in_pass.size()) == reached_before) {
+            *saturated = true;
+            break;
+        }
+    }
+    if (over_limit) return false;
+
+    // A final pass collecting the edges inside the region, each once.
+    edges->clear();
+    Edge edge = stream->readStream();
+    while (edge.first != -1) {
+        if (! over_limit && edge.first < edge.second && reached_in_pass.count(edge.first) > 0 && reached_in_pass.count(edge.second) > 0) {
+            edges->emplace_back(edge);
+            over_limit = static_cast<long>(edges->size()) > edge_limit;
+        }
+        edge = stream->readStream();
+    }
+    if (over_limit) edges->clear();
+
+    return ! over_limit;
+}
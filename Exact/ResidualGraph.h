@@ -0,0 +1,26 @@
+#ifndef RESIDUALGRAPH_H
+#define RESIDUALGRAPH_H
+
+#include <vector>
+
+#include "../types.h"
+#include "../Stream/Stream.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+// Collects the subgraph induced by the vertices within the given distance of the free vertices of the matching, in at
+// most distance + 1 passes. Every augmenting path of length at most 2 * distance + 1 lies inside it, and both vertices
+// of a matched edge are always collected together, so it can be matched independently of the rest of the graph.
+// Returns false once the pass in progress has finished if the subgraph has more than edge_limit edges. saturated is set
+// if the subgraph holds every component with a free vertex, in which case no augmenting path lies outside it.
+bool getResidualGraph(
+    Stream* stream,
+    Matching* matching,
+    int distance,
+    long edge_limit,
+    vector<Edge>* edges,
+    bool* saturated
+);
+
+#endif //RESIDUALGRAPH_H
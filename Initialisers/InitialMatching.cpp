@@ -0,0 +1,167 @@
+#include "InitialMatching.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+static unordered_map<Vertex, int> getDegrees(Stream* stream) {
+    // Both arcs of each edge are streamed, so counting the first vertex of each arc counts every edge once per endpoint.
+    unordered_map<Vertex, int> degrees;
+    Edge edge = stream->readStream();
+    while (edge.first != -1) {
+        degrees[edge.first] += 1;
+        edge = stream->readStream();
+    }
+    return degrees;
+}
+
+static bool isMatchable(Matching* matching, Edge edge) {
+    return edge.first != edge.second &&
+        ! matching->isVertexUsedInMatching(edge.first) &&
+        ! matching->isVertexUsedInMatching(edge.second);
+}
+
+Matching getDegreeAwareGreedyMatching(
+    Stream* stream,
+    int threshold_rounds
+) {
+    Matching matching;
+    unordered_map<Vertex, int> degrees = getDegrees(stream);
+
+    // Thresholds of 1, 2, 4, ... followed by a final unrestricted round.
+    int threshold = 1;
+    for (int round = 0; round <= threshold_rounds; round++, threshold *= 2) {
+        bool final_round = (round == threshold_rounds);
+
+        Edge edge = stream->readStream();
+        // edges are only -1 if we have reached the end of the stream.
+        while (edge.first != -1) {
+            if (
+                isMatchable(&matching, edge) &&
+                (final_round || min(degrees[edge.first], degrees[edge.second]) <= threshold)
+            ) {
+                matching.addEdge(edge);
+            }
+            // Reading next edge
+            edge = stream->readStream();
+        }
+    }
+
+    return matching;
+}
+
+static void matchBufferedEdges(
+    Matching* matching,
+    vector<Edge>* buffer,
+    unordered_map<Vertex, int>* edges_left
+) {
+    // Matching the edges whose endpoints have the fewest remaining chances first.
+    sort(buffer->begin(), buffer->end(), [edges_left](Edge a, Edge b) {
+        return (*edges_left)[a.first] + (*edges_left)[a.second] < (*edges_left)[b.first] + (*edges_left)[b.second];
+    });
+    for (Edge edge : *buffer) {
+        if (isMatchable(matching, edge)) matching->addEdge(edge);
+    }
+    buffer->clear();
+}
+
+Matching getKarpSipserMatching(
+    Stream* stream,
+    size_t buffer_size
+) {
+    Matching matching;
+    // Counts down as arcs are streamed, reaching 0 once the last arc starting at the vertex has been read.
+    unordered_map<Vertex, int> edges_left = getDegrees(stream);
+    vector<Edge> buffer;
+    buffer.reserve(buffer_size);
+
+    Edge edge = stream->readStream();
+    // edges are only -1 if we have reached the end of the stream.
+    while (edge.first != -1) {
+        edges_left[edge.first] -= 1;
+
+        if (isMatchable(&matching, edge)) {
+            if (edges_left[edge.first] == 0) {
+                // The degree 1 rule of Karp-Sipser, this is the last edge which can match edge.first.
+                matching.addEdge(edge);
+            } else if (edge.first < edge.second) {
+                // Only one arc of each edge is buffered.
+                buffer.emplace_back(edge);
+                if (buffer.size() >= buffer_size) matchBufferedEdges(&matching, &buffer, &edges_left);
+            }
+        }
+        // Reading next edge
+        edge = stream->readStream();
+    }
+    matchBufferedEdges(&matching, &buffer, &edges_left);
+
+    return matching;
+}
+
+long augmentLengthThreePaths(
+    Stream* stream,
+    Matching* matching,
+    int rounds
+) {
+    long total_augmentations = 0;
+
+    for (int round = 0; round < rounds; round++) {
+        // Up to two free neighbours of each matched vertex, two so that both ends of a matched edge can be given
+        // different free neighbours.
+        unordered_map<Vertex, pair<Vertex, Vertex>> free_neighbours;
+
+        Edge edge = stream->readStream();
+        // edges are only -1 if we have reached the end of the stream.
+        while (edge.first != -1) {
+            if (
+                edge.first != edge.second &&
+                matching->isVertexUsedInMatching(edge.first) &&
+                ! matching->isVertexUsedInMatching(edge.second)
+            ) {
+                auto found = free_neighbours.emplace(edge.first, make_pair(-1, -1));
+                pair<Vertex, Vertex>& neighbours = found.first->second;
+                if (neighbours.first == -1) neighbours.first = edge.second;
+                else if (neighbours.second == -1 && neighbours.first != edge.second) neighbours.second = edge.second;
+            }
+            // Reading next edge
+            edge = stream->readStream();
+        }
+
+        // Free vertices matched during this round, as each can only end one augmenting path.
+        unordered_set<Vertex> used;
+        long augmentations = 0;
+        vector<Edge> matched_edges(matching->matched_edges.begin(), matching->matched_edges.end());
+
+        for (Edge matched_edge : matched_edges) {
+            auto neighbours_of_u = free_neighbours.find(matched_edge.first);
+            auto neighbours_of_v = free_neighbours.find(matched_edge.second);
+            if (neighbours_of_u == free_neighbours.end() || neighbours_of_v == free_neighbours.end()) continue;
+
+            Vertex free_u = -1;
+            Vertex free_v = -1;
+            for (Vertex a : {neighbours_of_u->second.first, neighbours_of_u->second.second}) {
+                for (Vertex b : {neighbours_of_v->second.first, neighbours_of_v->second.second}) {
+                    if (free_u != -1) break;
+                    if (a == -1 || b == -1 || a == b || used.count(a) || used.count(b)) continue;
+                    free_u = a;
+                    free_v = b;
+                }
+            }
+            if (free_u == -1) continue;
+
+            // free_u - u = v - free_v becomes free_u = u - v = free_v.
+            matching->removeEdgeAndItsVertices(matched_edge);
+            matching->addEdge(make_pair(free_u, matched_edge.first));
+            matching->addEdge(make_pair(matched_edge.second, free_v));
+            used.insert(free_u);
+            used.insert(free_v);
+            augmentations += 1;
+        }
+
+        total_augmentations += augmentations;
+        if (augmentations == 0) break;
+    }
+
+    return total_augmentations;
+}
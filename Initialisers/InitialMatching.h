@@ -0,0 +1,40 @@
+#ifndef INITIALMATCHING_H
+#define INITIALMATCHING_H
+
+#include <cstddef>
+
+#include "../types.h"
+#include "../Stream/Stream.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+// Alternatives to the first fit greedy matching, which is only as good as the order of the edge stream. Each returns a
+// maximal matching, so still gives a 2 approximation.
+
+// Counts the degree of each vertex in one pass, then greedily matches in rounds of increasing degree threshold. An edge
+// is only accepted in a round if one of its endpoints has degree at most the threshold, so low degree vertices are
+// matched before their few neighbours are taken. The final round accepts any edge.
+Matching getDegreeAwareGreedyMatching(
+    Stream* stream,
+    int threshold_rounds = 3
+);
+
+// Streaming Karp-Sipser, taking one pass to count degrees and one to match. An edge is matched immediately if it is
+// the last edge of one of its endpoints still to be streamed, as that endpoint has no other chance to be matched.
+// Other edges are held in a buffer of at most buffer_size edges, which when full is greedily matched starting from
+// the edges whose endpoints have the fewest edges left to stream.
+Matching getKarpSipserMatching(
+    Stream* stream,
+    size_t buffer_size = 1 << 16
+);
+
+// Local improvement of a maximal matching, finding augmenting paths of length 3 (free - matched edge - free) in one
+// pass per round. Stops early if a round finds no augmentations. Returns the number of augmentations made.
+long augmentLengthThreePaths(
+    Stream* stream,
+    Matching* matching,
+    int rounds = 2
+);
+
+#endif //INITIALMATCHING_H
@@ -0,0 +1,122 @@
+#include "MaximumMatchings.h"
+
+#include <chrono>
+
+#include "Portfolio/Portfolio.h"
+#include "Weighted/WeightedMatching.h"
+
+static double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+MatchingResult runMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Config config
+) {
+    MatchingResult result;
+    int initial_passes = stream->number_of_passes;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    result.matching = getMMSSApproxMaximumMatching(stream, epsilon, config);
+
+    result.wall_time_ms = millisecondsSince(start);
+    result.passes = stream->number_of_passes - initial_passes;
+    result.matching_size = result.matching.matched_edges.size();
+    if (config.budget != nullptr) result.termination_reason = config.budget->termination_reason;
+    return result;
+}
+
+MatchingResult runMaximumMatching(
+    const vector<Edge>& edges,
+    float epsilon,
+    Config config,
+    int threads
+) {
+    if (threads <= 1) {
+        StreamFromMemory stream(edges);
+        return runMaximumMatching(&stream, epsilon, config);
+    }
+
+    MatchingResult result;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    vector<PortfolioInstanceResult> instance_results;
+    result.matching = getPortfolioApproxMaximumMatching(edges, epsilon, threads, config, false, &instance_results);
+
+    result.wall_time_ms = millisecondsSince(start);
+    result.matching_size = result.matching.matched_edges.size();
+    for (PortfolioInstanceResult instance_result : instance_results) {
+        if (instance_result.matching_size == result.matching_size) {
+            result.passes = instance_result.passes;
+            break;
+        }
+    }
+    return result;
+}
+
+MatchingResult runComponentMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Config config,
+    int threads,
+    long exact_edge_limit,
+    PreprocessingStatistics* statistics
+) {
+    PreprocessingStatistics unused_statistics;
+    if (statistics == nullptr) statistics = &unused_statistics;
+
+    MatchingResult result;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    result.matching = getComponentApproxMaximumMatching(stream, epsilon, config, threads, exact_edge_limit, statistics);
+
+    result.wall_time_ms = millisecondsSince(start);
+    result.passes = 1 + statistics->component_passes;
+    result.matching_size = result.matching.matched_edges.size();
+    return result;
+}
+
+MatchingResult runKernelisedMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Config config,
+    int max_rounds,
+    long max_folds,
+    KernelisationStatistics* statistics
+) {
+    MatchingResult result;
+    int initial_passes = stream->number_of_passes;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    KernelisedStream kernel(stream);
+    kernel.reduce(max_rounds, max_folds);
+    Matching kernel_matching = getMMSSApproxMaximumMatching(&kernel, epsilon, config);
+    result.matching = kernel.liftMatching(&kernel_matching);
+
+    result.wall_time_ms = millisecondsSince(start);
+    result.passes = stream->number_of_passes - initial_passes;
+    result.matching_size = result.matching.matched_edges.size();
+    if (config.budget != nullptr) result.termination_reason = config.budget->termination_reason;
+    if (statistics != nullptr) *statistics = kernel.statistics;
+    return result;
+}
+
+MatchingResult runMaximumWeightMatching(
+    WeightedStream* stream,
+    float epsilon,
+    Config config
+) {
+    MatchingResult result;
+    int initial_passes = stream->number_of_passes;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    result.matching = getWeightedApproxMaximumMatching(stream, epsilon, config);
+
+    result.wall_time_ms = millisecondsSince(start);
+    result.passes = stream->number_of_passes - initial_passes;
+    result.matching_size = result.matching.matched_edges.size();
+    // Computing the weight takes one more pass, which isn't counted as part of the run.
+    result.matching_weight = getMatchingWeight(stream, &result.matching);
+    return result;
+}
@@ -0,0 +1,86 @@
+#ifndef MAXIMUMMATCHINGS_H
+#define MAXIMUMMATCHINGS_H
+
+// Public interface of the MaximumMatchings library, for embedding the engine in another program.
+
+#include <vector>
+
+#include "types.h"
+#include "maxMatching.h"
+
+#include "Anytime/RunBudget.h"
+#include "Batch/BatchMatching.h"
+#include "Checkpoint/Checkpoint.h"
+#include "Memory/MemoryBudget.h"
+#include "Metrics/Metrics.h"
+#include "Preprocessing/GraphPreprocessing.h"
+#include "Preprocessing/KernelisedStream.h"
+#include "Stream/Stream.h"
+#include "Stream/StreamFromFile.h"
+#include "Stream/StreamFromMemory.h"
+#include "Stream/StreamFromPipe.h"
+#include "Stream/WeightedStream.h"
+#include "Stream/WeightedStreamFromMemory.h"
+#include "Structures/Matching.h"
+#include "Tracing/TraceLog.h"
+
+using namespace std;
+
+// Outcome of a single run of the engine.
+struct MatchingResult {
+    Matching matching;
+    long matching_size = 0;
+    // Total weight of the matching, only computed for weighted runs.
+    double matching_weight = 0;
+    int passes = 0;
+    double wall_time_ms = 0;
+    TerminationReason termination_reason = COMPLETED;
+};
+
+// Runs the MMSS algorithm on any stream, the number of passes reported is the number made by this run.
+MatchingResult runMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Config config
+);
+
+// Runs the MMSS algorithm on edges already in memory, avoiding any file round trip. With more than one thread a
+// portfolio of differently ordered runs is used and the passes reported are those of the best run.
+MatchingResult runMaximumMatching(
+    const vector<Edge>& edges,
+    float epsilon,
+    Config config,
+    int threads = 1
+);
+
+// Removes self loops and duplicate edges in one pass, then matches each connected component separately across the
+// given number of threads, holding the whole graph in memory. The passes reported are the preprocessing pass and those
+// of the slowest component.
+MatchingResult runComponentMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Config config,
+    int threads,
+    long exact_edge_limit = 4096,
+    PreprocessingStatistics* statistics = nullptr
+);
+
+// Removes degree one and degree two vertices in up to max_rounds rounds of reductions, runs the MMSS algorithm on the
+// kernel left, and lifts its matching back to the stream. The passes reported include those of the reductions.
+MatchingResult runKernelisedMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Config config,
+    int max_rounds,
+    long max_folds = -1,
+    KernelisationStatistics* statistics = nullptr
+);
+
+// Runs the weight class approximation of a maximum weight matching.
+MatchingResult runMaximumWeightMatching(
+    WeightedStream* stream,
+    float epsilon,
+    Config config
+);
+
+#endif //MAXIMUMMATCHINGS_H
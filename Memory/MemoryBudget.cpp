@@ -0,0 +1,88 @@
+#include "MemoryBudget.h"
+
+#include <algorithm>
+#include <queue>
+
+#include "../Structures/GraphStructure/GraphBlossom.h"
+#include "../Structures/GraphStructure/GraphVertex.h"
+
+long MemoryUsage::getTotal() const {
+    return structures + blossoms + edge_buffer + matching;
+}
+
+void MemoryUsage::takeMaximum(const MemoryUsage& other) {
+    structures = max(structures, other.structures);
+    blossoms = max(blossoms, other.blossoms);
+    edge_buffer = max(edge_buffer, other.edge_buffer);
+    matching = max(matching, other.matching);
+}
+
+long getEdgeBufferBytes(long edges) {
+    return edges * sizeof(Edge);
+}
+
+long getMatchingBytes(Matching* matching) {
+    return getTreeBytes(matching->matched_edges)
+        + getHashTableBytes(matching->vertex_to_matched_edge)
+        + getHashTableBytes(matching->matched_edge_to_label);
+}
+
+static long getBlossomBytes(GraphBlossom* blossom) {
+    long bytes = sizeof(GraphBlossom) + getTreeBytes(blossom->children);
+    bytes += getTreeBytes(blossom->nodesInBlossom) + getTreeBytes(blossom->verticesInBlossom);
+    bytes += blossom->nodesInOrder.capacity() * sizeof(GraphNode*);
+    bytes += getHashTableBytes(blossom->outsideBlossomToIn) + getHashTableBytes(blossom->nodeOfVertexInBlossom);
+
+    // The children of the nodes inside a blossom are also children of the blossom, so only the nodes themselves are
+    // counted here.
+    for (GraphNode* node : blossom->nodesInBlossom) {
+        if (node->isBlossom) bytes += getBlossomBytes(dynamic_cast<GraphBlossom*>(node));
+        else bytes += sizeof(GraphVertex) + getTreeBytes(node->children);
+    }
+    return bytes;
+}
+
+void addStructureBytes(FreeNodeStructure* structure, MemoryUsage* usage) {
+    usage->structures += sizeof(FreeNodeStructure) + getHashTableBytes(structure->vertex_to_graph_node);
+    // Each vertex of the structure also has an entry in AvailableFreeNodes' vertex_to_struct map.
+    usage->structures += structure->vertex_to_graph_node.size() * (sizeof(pair<const Vertex, FreeNodeStructure*>) + 3 * sizeof(void*));
+
+    // Walking the tree in the same way as deleteStructure.
+    queue<GraphNode*> to_visit;
+    to_visit.push(structure->free_node_root);
+    while (! to_visit.empty()) {
+        GraphNode* node = to_visit.front();
+        to_visit.pop();
+        for (GraphNode* child : node->children) {
+            to_visit.push(child);
+        }
+
+        if (node->isBlossom) usage->blossoms += getBlossomBytes(dynamic_cast<GraphBlossom*>(node));
+        else usage->structures += sizeof(GraphVertex) + getTreeBytes(node->children);
+    }
+}
+
+MemoryUsage getMemoryUsage(AvailableFreeNodes* available_free_nodes, Matching* matching) {
+    MemoryUsage usage;
+    usage.structures = available_free_nodes->free_node_structures.capacity() * sizeof(FreeNodeStructure*);
+    for (FreeNodeStructure* structure : available_free_nodes->free_node_structures) {
+        addStructureBytes(structure, &usage);
+    }
+    usage.matching = getMatchingBytes(matching);
+    return usage;
+}
+
+void MemoryBudget::record(const MemoryUsage& usage) {
+    peak.takeMaximum(usage);
+    measurements += 1;
+}
+
+bool MemoryBudget::isOverLimit(const MemoryUsage& usage) const {
+    return max_bytes >= 0 && usage.getTotal() > max_bytes;
+}
+
+long MemoryBudget::getEdgeBufferLimit(const MemoryUsage& usage) const {
+    if (max_bytes < 0) return -1;
+    long available_bytes = max_bytes - (usage.getTotal() - usage.edge_buffer);
+    return max(0L, available_bytes) / static_cast<long>(sizeof(Edge));
+}
@@ -0,0 +1,72 @@
+#ifndef MEMORYBUDGET_H
+#define MEMORYBUDGET_H
+
+#include "../types.h"
+#include "../Structures/AvailableFreeNodes.h"
+#include "../Structures/FreeNodeStructure.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+// Estimated bytes held by each part of the engine. Rather than tracking every allocation, the estimates count the
+// elements held by each container along with the per element overhead of the node based standard containers.
+struct MemoryUsage {
+    // The free node structure trees, along with AvailableFreeNodes' map from each vertex to its structure.
+    long structures = 0;
+    // Contents of the blossoms contracted within the structures.
+    long blossoms = 0;
+    // Edges held by contractAndAugment between the contraction pass and contracting them.
+    long edge_buffer = 0;
+    long matching = 0;
+
+    long getTotal() const;
+    void takeMaximum(const MemoryUsage& other);
+};
+
+// Estimated bytes held by a set or map, i.e. a red-black tree with a node per element.
+template <typename Tree>
+long getTreeBytes(const Tree& tree) {
+    return tree.size() * (sizeof(typename Tree::value_type) + 4 * sizeof(void*));
+}
+
+// Estimated bytes held by an unordered set or map, a singly linked node per element along with the bucket array.
+template <typename HashTable>
+long getHashTableBytes(const HashTable& hash_table) {
+    return hash_table.size() * (sizeof(typename HashTable::value_type) + 2 * sizeof(void*))
+        + hash_table.bucket_count() * sizeof(void*);
+}
+
+long getEdgeBufferBytes(long edges);
+long getMatchingBytes(Matching* matching);
+// Adds the bytes held by a free node structure to the structures and blossoms of usage.
+void addStructureBytes(FreeNodeStructure* structure, MemoryUsage* usage);
+MemoryUsage getMemoryUsage(AvailableFreeNodes* available_free_nodes, Matching* matching);
+
+// Records the peak memory used by a run and, if max_bytes is set, limits it. Only the free node structures and the
+// contraction edge buffer can be limited, so the engine degrades rather than fails when over the limit: growth of the
+// structures is held for a pass bundle, ending the phase (and freeing its structures) if that isn't enough, and the
+// edge buffer is contracted early whenever it would take the run over the limit. The structures are measured between
+// passes, so can go over the limit by as much as they grow in a single pass.
+class MemoryBudget {
+    // Variables
+    public:
+        // Limit on the estimated bytes used by the engine, negative for no limit.
+        long max_bytes = -1;
+        // Peak of each part separately, so the total of peak is an upper bound on the peak total.
+        MemoryUsage peak;
+        // Number of measurements taken, 0 if no phase of the MMSS algorithm ran, in which case peak means nothing.
+        long measurements = 0;
+        // Number of times each way of degrading was used to stay within max_bytes.
+        long held_pass_bundles = 0;
+        long phases_ended_early = 0;
+        long edge_buffer_flushes = 0;
+
+    // Functions
+    public:
+        void record(const MemoryUsage& usage);
+        bool isOverLimit(const MemoryUsage& usage) const;
+        // Number of edges the contraction pass can buffer without going over the limit, -1 if there isn't one.
+        long getEdgeBufferLimit(const MemoryUsage& usage) const;
+};
+
+#endif //MEMORYBUDGET_H
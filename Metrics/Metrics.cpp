@@ -0,0 +1,143 @@
+#include "Metrics.h"
+
+#include <algorithm>
+
+#include "../Structures/AvailableFreeNodes.h"
+
+static double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void Metrics::beginStage(int current_passes) {
+    stage_start_passes = current_passes;
+    stage_start_time = chrono::steady_clock::now();
+}
+
+void Metrics::endStage(string name, int current_passes, long matching_size) {
+    StageMetrics stage;
+    stage.name = name;
+    stage.passes = current_passes - stage_start_passes;
+    stage.matching_size = matching_size;
+    stage.wall_time_ms = millisecondsSince(stage_start_time);
+    stages.emplace_back(stage);
+}
+
+void Metrics::beginPhase(int new_scale_index, float new_scale, int new_phase) {
+    scale_index = new_scale_index;
+    scale = new_scale;
+    phase = new_phase;
+}
+
+void Metrics::beginPassBundle(int pass_bundle, int current_passes) {
+    PassBundleMetrics metrics;
+    metrics.scale_index = scale_index;
+    metrics.scale = scale;
+    metrics.phase = phase;
+    metrics.pass_bundle = pass_bundle;
+    pass_bundles.emplace_back(metrics);
+
+    pass_bundle_start_passes = current_passes;
+    pass_bundle_start_time = chrono::steady_clock::now();
+}
+
+void Metrics::recordMemory(const MemoryUsage& usage) {
+    PassBundleMetrics* metrics = currentPassBundle();
+    if (metrics != nullptr) metrics->memory.takeMaximum(usage);
+    peak_memory.takeMaximum(usage);
+}
+
+void Metrics::endPassBundle(AvailableFreeNodes* available_free_nodes, int current_passes) {
+    PassBundleMetrics* metrics = currentPassBundle();
+
+    for (FreeNodeStructure* structure : available_free_nodes->free_node_structures) {
+        metrics->structures += 1;
+        if (structure->on_hold) metrics->structures_on_hold += 1;
+        if (structure->removed) metrics->structures_removed += 1;
+        metrics->vertices_in_structures += structure->vertex_to_graph_node.size();
+    }
+
+    peak_vertices_in_structures = max(peak_vertices_in_structures, metrics->vertices_in_structures);
+    peak_structure_bytes = max(peak_structure_bytes, metrics->memory.structures + metrics->memory.blossoms);
+
+    metrics->passes = current_passes - pass_bundle_start_passes;
+    metrics->wall_time_ms = millisecondsSince(pass_bundle_start_time);
+}
+
+PassBundleMetrics* Metrics::currentPassBundle() {
+    if (pass_bundles.empty()) {
+        return nullptr;
+    }
+    return &pass_bundles.back();
+}
+
+void Metrics::writeJSON(ostream& os) const {
+    os << "{\n\"peak_vertices_in_structures\": " << peak_vertices_in_structures;
+    os << ",\n\"peak_structure_bytes\": " << peak_structure_bytes;
+    os << ",\n\"peak_memory\": {\"structures\": " << peak_memory.structures << ", \"blossoms\": " << peak_memory.blossoms;
+    os << ", \"edge_buffer\": " << peak_memory.edge_buffer << ", \"matching\": " << peak_memory.matching << "}";
+
+    os << ",\n\"stages\": [";
+    for (size_t i = 0; i < stages.size(); i++) {
+        const StageMetrics& stage = stages[i];
+        if (i > 0) os << ",";
+        os << "\n  {\"name\": \"" << stage.name << "\", \"passes\": " << stage.passes;
+        os << ", \"matching_size\": " << stage.matching_size << ", \"wall_time_ms\": " << stage.wall_time_ms << "}";
+    }
+
+    os << "\n],\n\"pass_bundles\": [";
+    for (size_t i = 0; i < pass_bundles.size(); i++) {
+        const PassBundleMetrics& m = pass_bundles[i];
+        if (i > 0) os << ",";
+        os << "\n  {\"scale_index\": " << m.scale_index << ", \"scale\": " << m.scale;
+        os << ", \"phase\": " << m.phase << ", \"pass_bundle\": " << m.pass_bundle;
+        os << ", \"overtakes_case_1\": " << m.overtakes_case_1;
+        os << ", \"overtakes_case_2_1\": " << m.overtakes_case_2_1;
+        os << ", \"overtakes_case_2_2\": " << m.overtakes_case_2_2;
+        os << ", \"contractions\": " << m.contractions;
+        os << ", \"augmentations\": " << m.augmentations;
+        os << ", \"backtracks\": " << m.backtracks;
+        os << ", \"edges_examined\": " << m.edges_examined;
+        os << ", \"edges_skipped_no_structure\": " << m.edges_skipped_no_structure;
+        os << ", \"edges_skipped_removed\": " << m.edges_skipped_removed;
+        os << ", \"edges_skipped_not_extendable\": " << m.edges_skipped_not_extendable;
+        os << ", \"edges_skipped_modified_or_on_hold\": " << m.edges_skipped_modified_or_on_hold;
+        os << ", \"edges_without_overtake\": " << m.edges_without_overtake;
+        os << ", \"structures\": " << m.structures;
+        os << ", \"structures_on_hold\": " << m.structures_on_hold;
+        os << ", \"structures_removed\": " << m.structures_removed;
+        os << ", \"vertices_in_structures\": " << m.vertices_in_structures;
+        os << ", \"structure_bytes\": " << m.memory.structures;
+        os << ", \"blossom_bytes\": " << m.memory.blossoms;
+        os << ", \"edge_buffer_bytes\": " << m.memory.edge_buffer;
+        os << ", \"matching_bytes\": " << m.memory.matching;
+        os << ", \"passes\": " << m.passes;
+        os << ", \"wall_time_ms\": " << m.wall_time_ms << "}";
+    }
+    os << "\n]\n}\n";
+}
+
+void Metrics::writeCSV(ostream& os) const {
+    os << "scale_index,scale,phase,pass_bundle,overtakes_case_1,overtakes_case_2_1,overtakes_case_2_2,";
+    os << "contractions,augmentations,backtracks,edges_examined,edges_skipped_no_structure,edges_skipped_removed,";
+    os << "edges_skipped_not_extendable,edges_skipped_modified_or_on_hold,edges_without_overtake,";
+    os << "structures,structures_on_hold,structures_removed,vertices_in_structures,";
+    os << "structure_bytes,blossom_bytes,edge_buffer_bytes,matching_bytes,passes,wall_time_ms\n";
+
+    for (const PassBundleMetrics& m : pass_bundles) {
+        os << m.scale_index << "," << m.scale << "," << m.phase << "," << m.pass_bundle << ",";
+        os << m.overtakes_case_1 << "," << m.overtakes_case_2_1 << "," << m.overtakes_case_2_2 << ",";
+        os << m.contractions << "," << m.augmentations << "," << m.backtracks << ",";
+        os << m.edges_examined << "," << m.edges_skipped_no_structure << "," << m.edges_skipped_removed << ",";
+        os << m.edges_skipped_not_extendable << "," << m.edges_skipped_modified_or_on_hold << "," << m.edges_without_overtake << ",";
+        os << m.structures << "," << m.structures_on_hold << "," << m.structures_removed << "," << m.vertices_in_structures << ",";
+        os << m.memory.structures << "," << m.memory.blossoms << "," << m.memory.edge_buffer << "," << m.memory.matching << ",";
+        os << m.passes << "," << m.wall_time_ms << "\n";
+    }
+}
+
+void Metrics::writeStagesCSV(ostream& os) const {
+    os << "name,passes,matching_size,wall_time_ms\n";
+    for (const StageMetrics& stage : stages) {
+        os << stage.name << "," << stage.passes << "," << stage.matching_size << "," << stage.wall_time_ms << "\n";
+    }
+}
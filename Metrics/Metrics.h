@@ -0,0 +1,88 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../types.h"
+#include "../Memory/MemoryBudget.h"
+
+using namespace std;
+
+// Counters collected over a single pass bundle of a phase.
+struct PassBundleMetrics {
+    int scale_index = 0;
+    float scale = 0;
+    int phase = 0;
+    int pass_bundle = 0;
+
+    // Operations completed.
+    long overtakes_case_1 = 0;
+    long overtakes_case_2_1 = 0;
+    long overtakes_case_2_2 = 0;
+    long contractions = 0;
+    long augmentations = 0;
+    long backtracks = 0;
+
+    // Arcs read by extendActivePath, and the number dropped by each of its early exits.
+    long edges_examined = 0;
+    long edges_skipped_no_structure = 0;
+    long edges_skipped_removed = 0;
+    long edges_skipped_not_extendable = 0;
+    long edges_skipped_modified_or_on_hold = 0;
+    long edges_without_overtake = 0;
+
+    // State of the free node structures at the end of the pass bundle.
+    int structures = 0;
+    int structures_on_hold = 0;
+    int structures_removed = 0;
+    long vertices_in_structures = 0;
+    // Peak estimated memory used during the pass bundle.
+    MemoryUsage memory;
+
+    int passes = 0;
+    double wall_time_ms = 0;
+};
+
+// Summary of a larger part of a run, i.e. computing the initial matching or a whole scale.
+struct StageMetrics {
+    string name;
+    int passes = 0;
+    long matching_size = 0;
+    double wall_time_ms = 0;
+};
+
+class Metrics {
+    // Variables
+    public:
+        vector<PassBundleMetrics> pass_bundles;
+        vector<StageMetrics> stages;
+        long peak_vertices_in_structures = 0;
+        long peak_structure_bytes = 0;
+        MemoryUsage peak_memory;
+    private:
+        int scale_index = 0;
+        float scale = 0;
+        int phase = 0;
+        int pass_bundle_start_passes = 0;
+        int stage_start_passes = 0;
+        chrono::steady_clock::time_point pass_bundle_start_time;
+        chrono::steady_clock::time_point stage_start_time;
+
+    // Functions
+    public:
+        void beginStage(int current_passes);
+        void endStage(string name, int current_passes, long matching_size);
+        void beginPhase(int new_scale_index, float new_scale, int new_phase);
+        void beginPassBundle(int pass_bundle, int current_passes);
+        void recordMemory(const MemoryUsage& usage);
+        void endPassBundle(AvailableFreeNodes* available_free_nodes, int current_passes);
+        PassBundleMetrics* currentPassBundle();
+        void writeJSON(ostream& os) const;
+        void writeCSV(ostream& os) const;
+        void writeStagesCSV(ostream& os) const;
+};
+
+#endif //METRICS_H
@@ -0,0 +1,69 @@
+#include "Portfolio.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "../maxMatching.h"
+#include "../Stream/PermutedStream.h"
+
+void SharedBestMatching::exchange(Matching* matching) {
+    lock_guard<mutex> lock(best_mutex);
+    if (matching->matched_edges.size() > best_size) {
+        best = *matching;
+        best_size = matching->matched_edges.size();
+    } else if (matching->matched_edges.size() < best_size) {
+        *matching = best;
+    }
+}
+
+Matching SharedBestMatching::getBest() {
+    lock_guard<mutex> lock(best_mutex);
+    return best;
+}
+
+Matching getPortfolioApproxMaximumMatching(
+    const vector<Edge>& edges,
+    float epsilon,
+    int instances,
+    Config config,
+    bool share_matchings,
+    vector<PortfolioInstanceResult>* instance_results
+) {
+    instances = max(1, instances);
+    // Tracing, metrics, budgets and checkpoints aren't shared between threads.
+    config.trace_log = nullptr;
+    config.metrics = nullptr;
+    config.budget = nullptr;
+    config.checkpoint = nullptr;
+    config.memory_budget = nullptr;
+
+    SharedBestMatching shared_best;
+    if (share_matchings) config.shared_best = &shared_best;
+
+    vector<Matching> matchings(instances);
+    vector<PortfolioInstanceResult> results(instances);
+    vector<thread> threads;
+
+    for (int instance = 0; instance < instances; instance++) {
+        threads.emplace_back([&, instance]() {
+            // Instance 0 keeps the original order of the edges.
+            PermutedStream stream(&edges, instance);
+            matchings[instance] = getMMSSApproxMaximumMatching(&stream, epsilon, config);
+
+            results[instance].seed = instance;
+            results[instance].matching_size = matchings[instance].matched_edges.size();
+            results[instance].passes = stream.number_of_passes;
+        });
+    }
+    for (thread& instance_thread : threads) {
+        instance_thread.join();
+    }
+
+    int best_instance = 0;
+    for (int instance = 1; instance < instances; instance++) {
+        if (results[instance].matching_size > results[best_instance].matching_size) best_instance = instance;
+    }
+
+    if (instance_results != nullptr) *instance_results = results;
+    return matchings[best_instance];
+}
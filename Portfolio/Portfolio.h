@@ -0,0 +1,45 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <mutex>
+#include <vector>
+
+#include "../types.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+// The largest matching found so far by any instance of a portfolio, exchanged at phase boundaries.
+class SharedBestMatching {
+    // Variables
+    private:
+        mutex best_mutex;
+        Matching best;
+        size_t best_size = 0;
+
+    // Functions
+    public:
+        void exchange(Matching* matching);
+        Matching getBest();
+};
+
+// Result of each instance of a portfolio run.
+struct PortfolioInstanceResult {
+    uint64_t seed = 0;
+    long matching_size = 0;
+    int passes = 0;
+};
+
+// Runs independent instances of the MMSS algorithm on separate threads, each streaming the same edge array in a
+// different deterministic order, returning the largest matching found. If share_matchings is set, each instance adopts
+// the largest matching found by any instance at the end of every phase, if it is larger than its own.
+Matching getPortfolioApproxMaximumMatching(
+    const vector<Edge>& edges,
+    float epsilon,
+    int instances,
+    Config config,
+    bool share_matchings = false,
+    vector<PortfolioInstanceResult>* instance_results = nullptr
+);
+
+#endif //PORTFOLIO_H
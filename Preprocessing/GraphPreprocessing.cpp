@@ -0,0 +1,131 @@
+#include "GraphPreprocessing.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
+static int findComponent(vector<int>* component_parent, int v) {
+    // Union-find with path halving.
+    while ((*component_parent)[v] != v) {
+        (*component_parent)[v] = (*component_parent)[(*component_parent)[v]];
+        v = (*component_parent)[v];
+    }
+    return v;
+}
+
+GraphBatch getConnectedComponents(Stream* stream, PreprocessingStatistics* statistics) {
+    PreprocessingStatistics unused_statistics;
+    if (statistics == nullptr) statistics = &unused_statistics;
+
+    // Vertices are relabelled to [0, n) so the union-find can use flat arrays.
+    unordered_map<Vertex, int> vertex_to_index;
+    vector<int> component_parent;
+    vector<int> component_size;
+    vector<Edge> edges;
+
+    long arcs = 0;
+    long self_loop_arcs = 0;
+    for (Edge arc = stream->readStream(); arc.first != -1; arc = stream->readStream()) {
+        arcs += 1;
+        if (arc.first == arc.second) {
+            self_loop_arcs += 1;
+            continue;
+        }
+        // Both arcs of each edge are streamed, so only the arc with the smaller vertex first is kept.
+        if (arc.first > arc.second) continue;
+        edges.emplace_back(arc);
+
+        int endpoints[2];
+        for (int i = 0; i < 2; i++) {
+            Vertex vertex = (i == 0) ? arc.first : arc.second;
+            unordered_map<Vertex, int>::iterator found = vertex_to_index.find(vertex);
+            if (found == vertex_to_index.end()) {
+                found = vertex_to_index.emplace(vertex, static_cast<int>(component_parent.size())).first;
+                component_parent.emplace_back(found->second);
+                component_size.emplace_back(1);
+            }
+            endpoints[i] = found->second;
+        }
+
+        // Union by size, keeping the trees shallow.
+        int u = findComponent(&component_parent, endpoints[0]);
+        int v = findComponent(&component_parent, endpoints[1]);
+        if (u == v) continue;
+        if (component_size[u] < component_size[v]) swap(u, v);
+        component_parent[v] = u;
+        component_size[u] += component_size[v];
+    }
+
+    sort(edges.begin(), edges.end());
+    size_t unique_edges = unique(edges.begin(), edges.end()) - edges.begin();
+
+    statistics->edges_read = arcs / 2;
+    statistics->self_loops = self_loop_arcs / 2;
+    statistics->duplicate_edges = edges.size() - unique_edges;
+    statistics->vertices = component_parent.size();
+    edges.resize(unique_edges);
+
+    // Counting the edges of each component, which are held at the root of its union-find tree.
+    int n = static_cast<int>(component_parent.size());
+    vector<size_t> component_edges(n, 0);
+    vector<int> edge_component(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        edge_component[i] = findComponent(&component_parent, vertex_to_index[edges[i].first]);
+        component_edges[edge_component[i]] += 1;
+    }
+
+    // Numbering the components largest first, so the largest components are started first when run in parallel.
+    vector<int> roots;
+    for (int v = 0; v < n; v++) {
+        if (component_parent[v] == v) roots.emplace_back(v);
+    }
+    stable_sort(roots.begin(), roots.end(), [&](int a, int b) {
+        return component_edges[a] > component_edges[b];
+    });
+
+    GraphBatch components;
+    vector<size_t> position(n, 0);
+    for (size_t i = 0; i < roots.size(); i++) {
+        components.names.emplace_back(to_string(i));
+        position[roots[i]] = components.edge_start.back();
+        components.edge_start.emplace_back(components.edge_start.back() + component_edges[roots[i]]);
+    }
+    components.edges.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        components.edges[position[edge_component[i]]++] = edges[i];
+    }
+
+    statistics->components = roots.size();
+    statistics->largest_component_edges = roots.empty() ? 0 : component_edges[roots[0]];
+    return components;
+}
+
+Matching getComponentApproxMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Config config,
+    int threads,
+    long exact_edge_limit,
+    PreprocessingStatistics* statistics
+) {
+    PreprocessingStatistics unused_statistics;
+    if (statistics == nullptr) statistics = &unused_statistics;
+
+    vector<BatchGraphResult> results;
+    {
+        GraphBatch components = getConnectedComponents(stream, statistics);
+        results = getBatchMatchings(components, epsilon, config, threads, exact_edge_limit, true);
+    }
+
+    // The components share no vertices, so their matchings are combined without any conflicts.
+    Matching matching;
+    statistics->component_passes = 0;
+    for (const BatchGraphResult& result : results) {
+        for (Edge edge : result.matched_edges) {
+            matching.addEdge(edge);
+        }
+        statistics->component_passes = max(statistics->component_passes, result.passes);
+    }
+
+    return matching;
+}
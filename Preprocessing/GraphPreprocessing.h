@@ -0,0 +1,41 @@
+#ifndef GRAPHPREPROCESSING_H
+#define GRAPHPREPROCESSING_H
+
+#include "../types.h"
+#include "../Batch/BatchMatching.h"
+#include "../Stream/Stream.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+struct PreprocessingStatistics {
+    long edges_read = 0;
+    long self_loops = 0;
+    long duplicate_edges = 0;
+    long vertices = 0;
+    long components = 0;
+    long largest_component_edges = 0;
+    // Largest number of passes made by the MMSS algorithm on a single component, 0 if all were solved exactly.
+    int component_passes = 0;
+};
+
+// Reads a single pass of the stream, removing self loops and duplicate edges, and splits the remaining edges into the
+// connected components of the graph. The components are found by a union-find updated as the edges are streamed, and
+// are returned largest first. Every edge is held in memory until it is copied into its component, so unlike the MMSS
+// algorithm this needs memory linear in the number of edges rather than the number of vertices.
+GraphBatch getConnectedComponents(Stream* stream, PreprocessingStatistics* statistics = nullptr);
+
+// Matches each connected component separately, spread over the given number of threads. Components with at most
+// exact_edge_limit edges are solved exactly, the rest by the MMSS algorithm with the given config. A matching of the
+// whole graph is the union of the matchings of its components, so no quality is lost by splitting. The components are
+// split in memory, as by getConnectedComponents.
+Matching getComponentApproxMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Config config,
+    int threads,
+    long exact_edge_limit = 4096,
+    PreprocessingStatistics* statistics = nullptr
+);
+
+#endif //GRAPHPREPROCESSING_H
@@ -0,0 +1,209 @@
+#include "KernelisedStream.h"
+
+// First two neighbours of a vertex in the current kernel, along with its degree.
+struct KernelVertex {
+    int degree = 0;
+    Vertex neighbour[2];
+    Edge edge[2];
+};
+
+KernelisedStream::KernelisedStream(Stream* stream) {
+    this->stream = stream;
+    number_of_passes = 0;
+}
+
+Vertex KernelisedStream::getRepresentative(Vertex vertex, int before_fold) {
+    /* Follows the chain of folds the vertex was merged by. A vertex is only ever merged into a vertex still in the
+       kernel, so the folds along the chain are in increasing order and the chain is never longer than the number of
+       rounds. */
+    while (true) {
+        unordered_map<Vertex, pair<Vertex, int>>::iterator found = merged_into.find(vertex);
+        if (found == merged_into.end() || found->second.second >= before_fold) return vertex;
+        vertex = found->second.first;
+    }
+}
+
+void KernelisedStream::addReducedEdge(Vertex u, Vertex v, Edge edge) {
+    reduced_matching[u] = edge;
+    reduced_matching[v] = edge;
+    removed_vertices.insert(u);
+    removed_vertices.insert(v);
+}
+
+Edge KernelisedStream::readKernelEdge(Edge* original_edge) {
+    while (true) {
+        *original_edge = stream->readStream();
+        if (original_edge->first == -1) {
+            number_of_passes += 1;
+            return *original_edge;
+        }
+
+        Vertex u = getRepresentative(original_edge->first);
+        Vertex v = getRepresentative(original_edge->second);
+        if (u == v || removed_vertices.count(u) > 0 || removed_vertices.count(v) > 0) continue;
+        return make_pair(u, v);
+    }
+}
+
+pair<int, int> KernelisedStream::readStream() {
+    Edge original_edge;
+    return readKernelEdge(&original_edge);
+}
+
+bool KernelisedStream::reduceOnce(long max_folds) {
+    /* A pass counting the degree of every vertex of the kernel, keeping its first two neighbours. Folds can leave
+       parallel edges, so a degree may be overestimated, which only means a reduction is missed. */
+    unordered_map<Vertex, KernelVertex> vertices;
+    Edge original_edge;
+    for (Edge edge = readKernelEdge(&original_edge); edge.first != -1; edge = readKernelEdge(&original_edge)) {
+        KernelVertex& vertex = vertices[edge.first];
+        if (vertex.degree < 2) {
+            vertex.neighbour[vertex.degree] = edge.second;
+            // The edge of the underlying stream is kept, as the matching is lifted back to it.
+            vertex.edge[vertex.degree] = original_edge;
+        }
+        vertex.degree += 1;
+    }
+    if (statistics.rounds == 0) statistics.vertices = vertices.size();
+    long reductions = statistics.degree_one_matches + statistics.triangle_matches + statistics.folds;
+
+    // Each vertex takes part in at most one reduction per round, so the reductions of a round are independent.
+    unordered_set<Vertex> touched;
+    bool reduced = false;
+
+    // A degree one vertex can always be matched to its neighbour in a maximum matching.
+    for (pair<const Vertex, KernelVertex>& entry : vertices) {
+        KernelVertex& vertex = entry.second;
+        bool single_neighbour = vertex.degree == 1 || (vertex.degree == 2 && vertex.neighbour[0] == vertex.neighbour[1]);
+        if (!single_neighbour) continue;
+
+        Vertex v = entry.first;
+        Vertex u = vertex.neighbour[0];
+        if (touched.count(v) > 0 || touched.count(u) > 0) continue;
+        touched.insert(v);
+        touched.insert(u);
+
+        addReducedEdge(v, u, vertex.edge[0]);
+        statistics.degree_one_matches += 1;
+        reduced = true;
+    }
+
+    vector<Fold> candidates;
+    // Neighbour of each candidate which also has degree two, or -1 if there is none.
+    vector<Vertex> degree_two_neighbour;
+    unordered_map<Vertex, size_t> candidate_of_neighbour;
+    for (pair<const Vertex, KernelVertex>& entry : vertices) {
+        KernelVertex& vertex = entry.second;
+        if (vertex.degree != 2 || vertex.neighbour[0] == vertex.neighbour[1]) continue;
+        if (max_folds >= 0 && static_cast<long>(folds.size() + candidates.size()) >= max_folds) break;
+
+        Fold fold = {entry.first, vertex.neighbour[0], vertex.neighbour[1], vertex.edge[0], vertex.edge[1]};
+        if (touched.count(fold.v) > 0 || touched.count(fold.a) > 0 || touched.count(fold.b) > 0) continue;
+        touched.insert(fold.v);
+        touched.insert(fold.a);
+        touched.insert(fold.b);
+
+        candidate_of_neighbour[fold.a] = candidates.size();
+        candidate_of_neighbour[fold.b] = candidates.size();
+        candidates.emplace_back(fold);
+        if (vertices.at(fold.a).degree == 2) degree_two_neighbour.emplace_back(fold.a);
+        else if (vertices.at(fold.b).degree == 2) degree_two_neighbour.emplace_back(fold.b);
+        else degree_two_neighbour.emplace_back(-1);
+    }
+    long vertices_in_kernel = vertices.size();
+    vertices.clear();
+
+    if (!candidates.empty()) {
+        // A second pass finding the degree two vertices whose neighbours are adjacent, which can't be folded.
+        vector<char> neighbours_adjacent(candidates.size(), 0);
+        for (Edge edge = readStream(); edge.first != -1; edge = readStream()) {
+            unordered_map<Vertex, size_t>::iterator first = candidate_of_neighbour.find(edge.first);
+            if (first == candidate_of_neighbour.end()) continue;
+            unordered_map<Vertex, size_t>::iterator second = candidate_of_neighbour.find(edge.second);
+            if (second == candidate_of_neighbour.end()) continue;
+            if (first->second == second->second) neighbours_adjacent[first->second] = 1;
+        }
+
+        for (size_t i = 0; i < candidates.size(); i++) {
+            Fold& fold = candidates[i];
+            if (neighbours_adjacent[i]) {
+                /* Two degree two vertices of a triangle only reach the rest of the graph through the third vertex, so
+                   can always be matched to each other in a maximum matching. Otherwise the vertex is left, as which
+                   neighbour it should be matched to depends on the rest of the graph. */
+                if (degree_two_neighbour[i] == -1) continue;
+                bool to_a = degree_two_neighbour[i] == fold.a;
+                addReducedEdge(fold.v, degree_two_neighbour[i], to_a ? fold.edge_to_a : fold.edge_to_b);
+                statistics.triangle_matches += 1;
+                reduced = true;
+            } else {
+                merged_into[fold.b] = make_pair(fold.a, static_cast<int>(folds.size()));
+                removed_vertices.insert(fold.v);
+                folds.emplace_back(fold);
+                statistics.folds += 1;
+                reduced = true;
+            }
+        }
+    }
+
+    // Every reduction removes two vertices from the kernel.
+    reductions = statistics.degree_one_matches + statistics.triangle_matches + statistics.folds - reductions;
+    statistics.residual_vertices = vertices_in_kernel - 2 * reductions;
+    statistics.rounds += 1;
+    return reduced;
+}
+
+void KernelisedStream::reduce(int max_rounds, long max_folds) {
+    int initial_passes = stream->number_of_passes;
+    for (int round = 0; round < max_rounds; round++) {
+        if (!reduceOnce(max_folds)) break;
+    }
+    statistics.passes = stream->number_of_passes - initial_passes;
+    number_of_passes = 0;
+}
+
+Matching KernelisedStream::liftMatching(Matching* kernel_matching) {
+    /* Finds an edge of the underlying stream for each edge of the kernel matching in one pass, then undoes the folds
+       from the last to the first. Before undoing fold t, each vertex matched by the lifted matching is keyed as it was
+       streamed after fold t, so the merged vertex is keyed as a. */
+    unordered_map<Vertex, Edge> lifted_matching = reduced_matching;
+    for (Edge edge = stream->readStream(); edge.first != -1; edge = stream->readStream()) {
+        Vertex u = getRepresentative(edge.first);
+        Vertex v = getRepresentative(edge.second);
+        if (u == v || !kernel_matching->isInMatching(make_pair(u, v))) continue;
+        if (lifted_matching.find(u) != lifted_matching.end()) continue;
+
+        lifted_matching[u] = edge;
+        lifted_matching[v] = edge;
+    }
+
+    for (int t = static_cast<int>(folds.size()) - 1; t >= 0; t--) {
+        Fold& fold = folds[t];
+
+        unordered_map<Vertex, Edge>::iterator found = lifted_matching.find(fold.a);
+        if (found == lifted_matching.end()) {
+            // Neither a nor b are matched, so either can be matched to v.
+            lifted_matching[fold.v] = fold.edge_to_a;
+            lifted_matching[fold.a] = fold.edge_to_a;
+            continue;
+        }
+
+        // Finding which of a and b the matched edge reaches, from the endpoint inside the merged vertex.
+        Edge edge = found->second;
+        Vertex inside = (getRepresentative(edge.first, t + 1) == fold.a) ? edge.first : edge.second;
+        if (getRepresentative(inside, t) == fold.a) {
+            lifted_matching[fold.v] = fold.edge_to_b;
+            lifted_matching[fold.b] = fold.edge_to_b;
+        } else {
+            lifted_matching[fold.b] = edge;
+            lifted_matching[fold.v] = fold.edge_to_a;
+            lifted_matching[fold.a] = fold.edge_to_a;
+        }
+    }
+
+    // Each matched edge is keyed by both of its original vertices.
+    Matching matching;
+    for (pair<const Vertex, Edge>& entry : lifted_matching) {
+        matching.addEdge(entry.second);
+    }
+    return matching;
+}
@@ -0,0 +1,74 @@
+#ifndef KERNELISEDSTREAM_H
+#define KERNELISEDSTREAM_H
+
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../types.h"
+#include "../Stream/Stream.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+struct KernelisationStatistics {
+    int rounds = 0;
+    // Passes of the underlying stream made by the reductions.
+    int passes = 0;
+    long vertices = 0;
+    long degree_one_matches = 0;
+    // Degree two vertices whose neighbours are adjacent, matched to a neighbour which also has degree two.
+    long triangle_matches = 0;
+    long folds = 0;
+    long residual_vertices = 0;
+};
+
+// A degree two vertex v whose neighbours a and b aren't adjacent, removed by merging a and b into a. A matching of the
+// folded graph is lifted to one a single edge larger by matching v to whichever of a and b is left free.
+struct Fold {
+    Vertex v;
+    Vertex a;
+    Vertex b;
+    // Edges of the underlying stream joining v to a and b.
+    Edge edge_to_a;
+    Edge edge_to_b;
+};
+
+// Streams the kernel of the underlying stream left by degree one and degree two reductions, which fix part of a
+// maximum matching without any augmenting path search. Each round of reductions takes a pass counting degrees, and a
+// second pass if there are degree two vertices to check for triangles. Vertices merged by folds are streamed as the
+// vertex they were merged into, so a matching of the kernel is lifted back to the original graph with liftMatching.
+class KernelisedStream : public Stream {
+    // Variables
+    public:
+        KernelisationStatistics statistics;
+    private:
+        Stream* stream;
+        // Vertices removed by the reductions, either matched or folded away.
+        unordered_set<Vertex> removed_vertices;
+        // A vertex merged by a fold points to the vertex it was merged into, along with the index of the fold.
+        unordered_map<Vertex, pair<Vertex, int>> merged_into;
+        vector<Fold> folds;
+        // Edges of the underlying stream fixed by the reductions, keyed by both of their vertices at the time.
+        unordered_map<Vertex, Edge> reduced_matching;
+
+    // Functions
+    public:
+        KernelisedStream(Stream* stream);
+        // Runs rounds of reductions until nothing changes or max_rounds is reached. At most max_folds folds are kept,
+        // as each is held in memory until the matching is lifted, -1 for no limit.
+        void reduce(int max_rounds, long max_folds = -1);
+        pair<int, int> readStream() override;
+        // Lifts a matching of the kernel to a matching of the underlying stream, taking one pass.
+        Matching liftMatching(Matching* kernel_matching);
+    private:
+        // Reads the next edge of the kernel, along with the edge of the underlying stream it was read from.
+        Edge readKernelEdge(Edge* original_edge);
+        bool reduceOnce(long max_folds);
+        void addReducedEdge(Vertex u, Vertex v, Edge edge);
+        // The vertex streamed in place of the given vertex, only counting the folds before before_fold.
+        Vertex getRepresentative(Vertex vertex, int before_fold = numeric_limits<int>::max());
+};
+
+#endif //KERNELISEDSTREAM_H
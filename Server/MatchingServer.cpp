@@ -0,0 +1,287 @@
+#include "MatchingServer.h"
+
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../Checkpoint/Checkpoint.h"
+#include "../Stream/PermutedStream.h"
+
+static bool writeAll(int fd, string data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t bytes = write(fd, data.data() + written, data.size() - written);
+        if (bytes < 0 && errno == EINTR) continue;
+        if (bytes <= 0) return false;
+        written += bytes;
+    }
+    return true;
+}
+
+MatchingServer::MatchingServer(string socket_path, int workers) : listen_fd(-1), stopping(false) {
+    this->socket_path = socket_path;
+    this->workers = max(1, workers);
+}
+
+bool MatchingServer::loadGraph(string name, string file_name, long* number_of_edges) {
+    if (! ifstream(file_name)) return false;
+
+    // StreamFromMemory holds both arcs of each edge next to each other, only the first is kept.
+    StreamFromMemory stream(file_name);
+    vector<Edge> edges;
+    long arc_number = 0;
+    for (Edge arc = stream.readStream(); arc.first != -1; arc = stream.readStream(), arc_number++) {
+        if (arc_number % 2 == 0) edges.emplace_back(arc);
+    }
+    *number_of_edges = edges.size();
+
+    // Jobs already running on a graph being replaced keep their own reference to it.
+    shared_ptr<const vector<Edge>> graph = make_shared<const vector<Edge>>(move(edges));
+    lock_guard<mutex> lock(graphs_mutex);
+    graphs[name] = graph;
+    return true;
+}
+
+bool MatchingServer::run() {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (fd == -1 || socket_path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Could not create the socket " << socket_path << '\n';
+        return false;
+    }
+    socket_path.copy(address.sun_path, socket_path.size());
+
+    // Removing a socket left behind by a previous server.
+    unlink(socket_path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 || listen(fd, 64) == -1) {
+        std::cerr << "Could not listen on the socket " << socket_path << '\n';
+        close(fd);
+        return false;
+    }
+    listen_fd = fd;
+    // stop may have been called before the socket was open.
+    if (stopping) shutdown(fd, SHUT_RDWR);
+
+    vector<thread> worker_threads;
+    for (int i = 0; i < workers; i++) {
+        worker_threads.emplace_back(&MatchingServer::runWorker, this);
+    }
+
+    while (! stopping) {
+        int connection_fd = accept(fd, nullptr, nullptr);
+        if (connection_fd == -1) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        lock_guard<mutex> lock(connections_mutex);
+        connection_fds.insert(connection_fd);
+        thread(&MatchingServer::serveConnection, this, connection_fd).detach();
+    }
+
+    // Queued jobs are still run and answered, but nothing more is read from the clients.
+    stopping = true;
+    {
+        lock_guard<mutex> lock(jobs_mutex);
+        jobs_changed.notify_all();
+    }
+    {
+        unique_lock<mutex> lock(connections_mutex);
+        for (int connection_fd : connection_fds) {
+            shutdown(connection_fd, SHUT_RD);
+        }
+        connections_changed.wait(lock, [this] { return connection_fds.empty(); });
+    }
+    for (thread& worker_thread : worker_threads) {
+        worker_thread.join();
+    }
+
+    close(fd);
+    unlink(socket_path.c_str());
+    return true;
+}
+
+void MatchingServer::stop() {
+    stopping = true;
+    // Wakes the accept call of run.
+    int fd = listen_fd;
+    if (fd != -1) shutdown(fd, SHUT_RDWR);
+}
+
+void MatchingServer::runWorker() {
+    while (true) {
+        shared_ptr<MatchingJob> job;
+        {
+            unique_lock<mutex> lock(jobs_mutex);
+            jobs_changed.wait(lock, [this] { return stopping || ! jobs.empty(); });
+            if (jobs.empty()) return;
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        // Every job streams the resident edge array in its original order without copying it.
+        PermutedStream stream(job->edges.get(), 0);
+        if (job->warm_start_file.empty()) {
+            job->result = runMaximumMatching(&stream, job->epsilon, job->config);
+        } else {
+            Matching saved_matching;
+            if (loadMatching(job->warm_start_file, &saved_matching)) {
+                chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                job->result.matching = warmStartMMSSApproxMaximumMatching(
+                    &stream, job->epsilon, &saved_matching, job->first_scale, job->config
+                );
+                job->result.wall_time_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+                job->result.passes = stream.number_of_passes;
+                job->result.matching_size = job->result.matching.matched_edges.size();
+                job->result.termination_reason = job->budget.termination_reason;
+            } else {
+                job->error = "could not read warm start matching " + job->warm_start_file;
+            }
+        }
+        job->done.set_value();
+    }
+}
+
+void MatchingServer::serveConnection(int connection_fd) {
+    string buffer;
+    char read_buffer[4096];
+    bool open = true;
+    while (open) {
+        ssize_t bytes = read(connection_fd, read_buffer, sizeof(read_buffer));
+        if (bytes < 0 && errno == EINTR) continue;
+        if (bytes <= 0) break;
+        buffer.append(read_buffer, bytes);
+
+        size_t line_end;
+        while (open && (line_end = buffer.find('\n')) != string::npos) {
+            string request = buffer.substr(0, line_end);
+            buffer.erase(0, line_end + 1);
+            if (! request.empty() && request.back() == '\r') request.pop_back();
+            if (request.empty()) continue;
+
+            open = writeAll(connection_fd, handleRequest(request));
+        }
+    }
+
+    lock_guard<mutex> lock(connections_mutex);
+    connection_fds.erase(connection_fd);
+    close(connection_fd);
+    connections_changed.notify_all();
+}
+
+string MatchingServer::handleRequest(string request) {
+    vector<string> arguments;
+    stringstream request_stream(request);
+    string argument;
+    while (request_stream >> argument) {
+        arguments.emplace_back(argument);
+    }
+    // A line of only whitespace has no command.
+    if (arguments.empty()) return "ERROR empty request\n";
+    string command = arguments[0];
+
+    try {
+        if (command == "LOAD" && arguments.size() == 3) {
+            long number_of_edges = 0;
+            if (! loadGraph(arguments[1], arguments[2], &number_of_edges)) return "ERROR could not read " + arguments[2] + "\n";
+            return "OK " + to_string(number_of_edges) + "\n";
+        }
+        if (command == "UNLOAD" && arguments.size() == 2) {
+            lock_guard<mutex> lock(graphs_mutex);
+            if (graphs.erase(arguments[1]) == 0) return "ERROR no graph " + arguments[1] + "\n";
+            return "OK\n";
+        }
+        if (command == "LIST" && arguments.size() == 1) {
+            string response = "OK";
+            lock_guard<mutex> lock(graphs_mutex);
+            for (pair<const string, shared_ptr<const vector<Edge>>>& graph : graphs) {
+                response += " " + graph.first + ":" + to_string(graph.second->size());
+            }
+            return response + "\n";
+        }
+        if (command == "MATCH" && arguments.size() >= 3) {
+            return handleMatch(arguments);
+        }
+        if (command == "SHUTDOWN" && arguments.size() == 1) {
+            stop();
+            return "OK\n";
+        }
+    } catch (const exception&) {
+        // Thrown by stoi and stof for arguments which aren't numbers.
+        return "ERROR invalid request: " + request + "\n";
+    }
+    return "ERROR unknown request: " + request + "\n";
+}
+
+string MatchingServer::handleMatch(vector<string>& arguments) {
+    shared_ptr<MatchingJob> job = make_shared<MatchingJob>();
+    {
+        lock_guard<mutex> lock(graphs_mutex);
+        auto graph = graphs.find(arguments[1]);
+        if (graph == graphs.end()) return "ERROR no graph " + arguments[1] + "\n";
+        job->edges = graph->second;
+    }
+    job->epsilon = stof(arguments[2]);
+    job->config.progress_report = NO_OUTPUT;
+    job->config.optimisation_level = PHASE_SKIP;
+    job->config.budget = &job->budget;
+
+    string save_file;
+    string output_file;
+    bool send_edges = false;
+    for (size_t i = 3; i < arguments.size(); i++) {
+        size_t separator = arguments[i].find('=');
+        if (separator == string::npos) return "ERROR invalid option " + arguments[i] + "\n";
+        string key = arguments[i].substr(0, separator);
+        string value = arguments[i].substr(separator + 1);
+
+        if (key == "optimisation") job->config.optimisation_level = static_cast<OptimisationLevel>(max(0, min(3, stoi(value))));
+        else if (key == "initialiser" && value == "greedy") job->config.initial_matching = GREEDY;
+        else if (key == "initialiser" && value == "degree") job->config.initial_matching = DEGREE_AWARE_GREEDY;
+        else if (key == "initialiser" && value == "karp-sipser") job->config.initial_matching = KARP_SIPSER;
+        else if (key == "max_passes") job->budget.max_passes = stoi(value);
+        else if (key == "max_seconds") job->budget.max_seconds = stod(value);
+        else if (key == "target_ratio") job->budget.target_ratio = stof(value);
+        else if (key == "warm_start") job->warm_start_file = value;
+        else if (key == "first_scale") job->first_scale = stoi(value);
+        else if (key == "save") save_file = value;
+        else if (key == "output") output_file = value;
+        else if (key == "edges") send_edges = value == "1";
+        else return "ERROR invalid option " + arguments[i] + "\n";
+    }
+
+    future<void> done = job->done.get_future();
+    {
+        lock_guard<mutex> lock(jobs_mutex);
+        if (stopping) return "ERROR server is shutting down\n";
+        jobs.emplace_back(job);
+        jobs_changed.notify_one();
+    }
+    done.wait();
+
+    if (! job->error.empty()) return "ERROR " + job->error + "\n";
+    MatchingResult& result = job->result;
+    if (! save_file.empty() && ! saveMatching(save_file, &result.matching)) return "ERROR could not write " + save_file + "\n";
+    if (! output_file.empty()) {
+        ofstream output(output_file);
+        for (Edge edge : result.matching.matched_edges) {
+            output << edge.first << " " << edge.second << '\n';
+        }
+    }
+
+    stringstream response;
+    response << "OK " << result.matching_size << " " << result.passes << " " << result.wall_time_ms << " ";
+    response << result.termination_reason << '\n';
+    if (send_edges) {
+        for (Edge edge : result.matching.matched_edges) {
+            response << edge.first << " " << edge.second << '\n';
+        }
+        response << "END" << '\n';
+    }
+    return response.str();
+}
@@ -0,0 +1,82 @@
+#ifndef MATCHINGSERVER_H
+#define MATCHINGSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../MaximumMatchings.h"
+
+using namespace std;
+
+// A matching query, run by one of the server's engine workers against a resident graph.
+struct MatchingJob {
+    shared_ptr<const vector<Edge>> edges;
+    float epsilon = 0.25f;
+    Config config;
+    RunBudget budget;
+    // If set, the run starts from the matching saved in this file, see saveMatching.
+    string warm_start_file;
+    int first_scale = 0;
+
+    MatchingResult result;
+    string error;
+    promise<void> done;
+};
+
+// A long running server keeping graphs in memory, so that many matching queries can be run against them without each
+// loading the graph again. Clients connect over a Unix domain socket and send one request per line:
+//     LOAD NAME FILE                   loads the edge list in FILE as graph NAME, replacing any graph of that name
+//     UNLOAD NAME                      frees graph NAME once the jobs using it finish
+//     LIST                             lists the resident graphs and their number of edges
+//     MATCH NAME EPSILON [KEY=VALUE]   queues a matching job on graph NAME, with options optimisation, initialiser
+//                                      (greedy, degree, karp-sipser), max_passes, max_seconds, target_ratio,
+//                                      warm_start, first_scale, save (saves the matching for warm starts), output
+//                                      (writes the matched edges) and edges=1 (sends the matched edges)
+//     SHUTDOWN                         stops accepting connections and exits once the queued jobs finish
+// Each request is answered by a line starting with OK or ERROR. A MATCH is answered once its job has run with
+// "OK SIZE PASSES WALL_TIME_MS TERMINATION_REASON", followed, with edges=1, by a line "u v" per matched edge and END.
+class MatchingServer {
+    // Variables
+    private:
+        string socket_path;
+        int workers;
+        atomic<int> listen_fd;
+        atomic<bool> stopping;
+
+        mutex graphs_mutex;
+        unordered_map<string, shared_ptr<const vector<Edge>>> graphs;
+
+        mutex jobs_mutex;
+        condition_variable jobs_changed;
+        deque<shared_ptr<MatchingJob>> jobs;
+
+        // Connection threads are detached, each removing its descriptor once it finishes.
+        mutex connections_mutex;
+        condition_variable connections_changed;
+        set<int> connection_fds;
+
+    // Functions
+    public:
+        MatchingServer(string socket_path, int workers);
+        bool loadGraph(string name, string file_name, long* number_of_edges);
+        // Accepts connections until stop is called, returning false if the socket couldn't be opened.
+        bool run();
+        // Safe to call from a signal handler.
+        void stop();
+    private:
+        void runWorker();
+        void serveConnection(int connection_fd);
+        string handleRequest(string request);
+        string handleMatch(vector<string>& arguments);
+};
+
+#endif //MATCHINGSERVER_H
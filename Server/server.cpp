@@ -0,0 +1,70 @@
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "MatchingServer.h"
+
+using namespace std;
+
+static MatchingServer* server = nullptr;
+
+static void requestStop(int /*signal_number*/) {
+    if (server != nullptr) server->stop();
+}
+
+static void printUsage() {
+    std::cerr << "Usage: MaximumMatchingsServer [options]\n"
+        << "  --socket PATH       Unix domain socket to listen on (default /tmp/MaximumMatchings.sock)\n"
+        << "  --workers N         number of matching jobs run at once (default one per hardware thread)\n"
+        << "  --load NAME=FILE    loads a graph before accepting connections, can be repeated\n"
+        << "See Server/MatchingServer.h for the requests clients can send.\n";
+}
+
+int main(int argc, char* argv[]) {
+    string socket_path = "/tmp/MaximumMatchings.sock";
+    int workers = static_cast<int>(thread::hardware_concurrency());
+    vector<pair<string, string>> graphs_to_load;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--socket" && has_value) socket_path = argv[++i];
+        else if (arg == "--workers" && has_value) workers = stoi(argv[++i]);
+        else if (arg == "--load" && has_value) {
+            string graph = argv[++i];
+            size_t separator = graph.find('=');
+            if (separator == string::npos) {
+                printUsage();
+                return 1;
+            }
+            graphs_to_load.emplace_back(graph.substr(0, separator), graph.substr(separator + 1));
+        }
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    MatchingServer matching_server(socket_path, workers);
+    for (pair<string, string> graph : graphs_to_load) {
+        long number_of_edges = 0;
+        if (! matching_server.loadGraph(graph.first, graph.second, &number_of_edges)) {
+            std::cerr << "Could not read " << graph.second << '\n';
+            return 1;
+        }
+        std::cout << "Loaded " << graph.first << " with " << number_of_edges << " edges" << '\n';
+    }
+
+    server = &matching_server;
+    signal(SIGINT, requestStop);
+    signal(SIGTERM, requestStop);
+    // Clients closing their connection early shouldn't end the server.
+    signal(SIGPIPE, SIG_IGN);
+
+    std::cout << "Listening on " << socket_path << " with " << workers << " workers" << '\n';
+    bool listened = matching_server.run();
+    server = nullptr;
+    return listened ? 0 : 1;
+}
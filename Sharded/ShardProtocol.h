@@ -0,0 +1,41 @@
+#ifndef SHARDPROTOCOL_H
+#define SHARDPROTOCOL_H
+
+#include <cstdint>
+
+#include <unistd.h>
+
+// Protocol between the coordinator and its workers over a pair of pipes. The coordinator sends a single command byte,
+// and in reply to SHARD_PASS the worker sends each edge of its shard once, as blocks of a uint32_t edge count followed
+// by that many pairs of int32_t vertices. A block with a count of 0 ends the pass. SHARD_FILTERED_PASS is followed by a
+// uint32_t vertex count and that many int32_t vertices, and the worker only sends the edges with both vertices among
+// them. A worker which can't load its shard exits before reading any command.
+const char SHARD_PASS = 'P';
+const char SHARD_FILTERED_PASS = 'F';
+const char SHARD_QUIT = 'Q';
+const uint32_t SHARD_BLOCK_EDGES = 4096;
+
+// Reads or writes exactly size bytes, retrying partial transfers. Returns false on error or end of file.
+inline bool readFully(int fd, void* data, size_t size) {
+    char* position = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t transferred = read(fd, position, size);
+        if (transferred <= 0) return false;
+        position += transferred;
+        size -= transferred;
+    }
+    return true;
+}
+
+inline bool writeFully(int fd, const void* data, size_t size) {
+    const char* position = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t transferred = write(fd, position, size);
+        if (transferred <= 0) return false;
+        position += transferred;
+        size -= transferred;
+    }
+    return true;
+}
+
+#endif //SHARDPROTOCOL_H
@@ -0,0 +1,139 @@
+#include "ShardedStream.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ShardProtocol.h"
+
+ShardedStream::ShardedStream(string worker_path, string file_name, int number_of_workers) {
+    number_of_passes = 0;
+
+    for (int shard_index = 0; shard_index < number_of_workers; shard_index++) {
+        int command_pipe[2];
+        int edge_pipe[2];
+        if (pipe(command_pipe) != 0 || pipe(edge_pipe) != 0) {
+            std::cerr << "Unable to create pipes for shard worker" << '\n';
+            exit(1);
+        }
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            dup2(command_pipe[0], STDIN_FILENO);
+            dup2(edge_pipe[1], STDOUT_FILENO);
+            close(command_pipe[0]);
+            close(command_pipe[1]);
+            close(edge_pipe[0]);
+            close(edge_pipe[1]);
+            // Workers started earlier must not inherit the pipes of other workers, else they never see end of file.
+            for (Worker worker : workers) {
+                close(worker.command_fd);
+                close(worker.edge_fd);
+            }
+
+            string shard_text = to_string(shard_index);
+            string count_text = to_string(number_of_workers);
+            execl(worker_path.c_str(), worker_path.c_str(), file_name.c_str(), shard_text.c_str(), count_text.c_str(), nullptr);
+            _exit(127);
+        }
+
+        close(command_pipe[0]);
+        close(edge_pipe[1]);
+        workers.push_back({pid, command_pipe[1], edge_pipe[0]});
+    }
+}
+
+ShardedStream::~ShardedStream() {
+    for (Worker worker : workers) {
+        writeFully(worker.command_fd, &SHARD_QUIT, 1);
+        close(worker.command_fd);
+        close(worker.edge_fd);
+        waitpid(worker.pid, nullptr, 0);
+    }
+}
+
+void ShardedStream::failWorker() {
+    /* Reports a worker which stopped sending its shard, along with how it ended. The worker has already written its
+       own error, such as its input not being readable, to the shared stderr. */
+    int status = 0;
+    Worker& worker = workers[current_worker];
+    close(worker.edge_fd);
+    waitpid(worker.pid, &status, 0);
+    std::cerr << "Shard worker " << current_worker << " stopped unexpectedly";
+    if (WIFEXITED(status)) std::cerr << " with exit code " << WEXITSTATUS(status);
+    else if (WIFSIGNALED(status)) std::cerr << " on signal " << WTERMSIG(status);
+    std::cerr << '\n';
+    exit(1);
+}
+
+bool ShardedStream::readBlock() {
+    /* Reads the next block of edges from the current worker, returning false once the worker's shard is finished. */
+    uint32_t count;
+    if (!readFully(workers[current_worker].edge_fd, &count, sizeof(count))) failWorker();
+    if (count == 0) return false;
+
+    block.resize(2 * count);
+    if (!readFully(workers[current_worker].edge_fd, block.data(), block.size() * sizeof(int32_t))) failWorker();
+    block_position = 0;
+    edges_received += count;
+    return true;
+}
+
+bool ShardedStream::canRestrictPasses() const {
+    return true;
+}
+
+void ShardedStream::restrictNextPass(const vector<int>& vertices) {
+    restrict_next_pass = true;
+    pass_vertices.assign(vertices.begin(), vertices.end());
+}
+
+pair<int, int> ShardedStream::readStream() {
+    // Returning the second arc of the edge.
+    if (show_last_edge) {
+        show_last_edge = false;
+        return last_edge;
+    }
+
+    // Every worker is asked at the start of the pass, so later shards are already being sent while earlier ones are read.
+    if (!pass_requested) {
+        uint32_t number_of_vertices = static_cast<uint32_t>(pass_vertices.size());
+        for (Worker worker : workers) {
+            if (!restrict_next_pass) {
+                writeFully(worker.command_fd, &SHARD_PASS, 1);
+            } else {
+                writeFully(worker.command_fd, &SHARD_FILTERED_PASS, 1);
+                writeFully(worker.command_fd, &number_of_vertices, sizeof(number_of_vertices));
+                writeFully(worker.command_fd, pass_vertices.data(), pass_vertices.size() * sizeof(int32_t));
+            }
+        }
+        restrict_next_pass = false;
+        pass_requested = true;
+        current_worker = 0;
+        block.clear();
+        block_position = 0;
+    }
+
+    while (block_position >= block.size()) {
+        if (current_worker < workers.size() && readBlock()) break;
+        if (current_worker < workers.size()) current_worker++;
+
+        // Occurs when we are at the end of the stream.
+        if (current_worker >= workers.size()) {
+            pass_requested = false;
+            block.clear();
+            block_position = 0;
+            number_of_passes += 1;
+            return make_pair(-1, -1);
+        }
+    }
+
+    pair<int, int> edge = make_pair(block[block_position], block[block_position + 1]);
+    block_position += 2;
+
+    last_edge = make_pair(edge.second, edge.first);
+    show_last_edge = true;
+    return edge;
+}
@@ -0,0 +1,52 @@
+#ifndef SHARDEDSTREAM_H
+#define SHARDEDSTREAM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "../Stream/Stream.h"
+
+using namespace std;
+
+// Streams an edge list file held by worker processes, each owning a shard of the file, so the edges themselves never
+// live in this process. Each pass asks every worker to stream its shard through a pipe, the shards are read in turn,
+// and both arcs of each edge are returned as with the other streams. A restricted pass is filtered by the workers, so
+// only the edges the engine needs are sent. If a worker fails, the error is reported and the process exits.
+class ShardedStream : public Stream {
+    public:
+        // Edges sent by the workers over every pass, lower than the edges in the file times the passes once passes are
+        // restricted.
+        long edges_received = 0;
+    private:
+        struct Worker {
+            pid_t pid;
+            int command_fd;
+            int edge_fd;
+        };
+
+        vector<Worker> workers;
+        size_t current_worker = 0;
+        bool pass_requested = false;
+        // Vertices the next pass is restricted to, if restrict_next_pass is set.
+        bool restrict_next_pass = false;
+        vector<int32_t> pass_vertices;
+        vector<int32_t> block;
+        size_t block_position = 0;
+        pair<int, int> last_edge = make_pair(-1, -1);
+        bool show_last_edge = false;
+
+    public:
+        ShardedStream(string worker_path, string file_name, int number_of_workers);
+        ~ShardedStream() override;
+        pair<int, int> readStream() override;
+        bool canRestrictPasses() const override;
+        void restrictNextPass(const vector<int>& vertices) override;
+    private:
+        bool readBlock();
+        [[noreturn]] void failWorker();
+};
+
+#endif //SHARDEDSTREAM_H
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "ShardedStream.h"
+
+#include "../maxMatching.h"
+#include "../types.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+static void printUsage() {
+    std::cerr << "Usage: MaximumMatchingsCoordinator --input FILE [options]\n"
+        << "  --input FILE          edge list file, split between the workers\n"
+        << "  --workers LIST        comma separated worker counts to run with (default 1,2,4)\n"
+        << "  --worker PATH         worker executable (default MaximumMatchingsWorker next to this executable)\n"
+        << "  --epsilon VALUE       epsilon of the approximation (default 0.25)\n"
+        << "  --optimisation LEVEL  optimisation level (default 3)\n"
+        << "  --pass-benchmark N    only time N passes of the stream for each worker count\n";
+}
+
+static vector<int> splitList(string list) {
+    vector<int> items;
+    stringstream stream(list);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) items.emplace_back(stoi(item));
+    }
+    return items;
+}
+
+static long countEdges(Stream* stream) {
+    long arcs = 0;
+    for (Edge edge = stream->readStream(); edge.first != -1; edge = stream->readStream()) arcs++;
+    return arcs / 2;
+}
+
+int main(int argc, char* argv[]) {
+    string input_file;
+    vector<int> worker_counts = {1, 2, 4};
+    string program = argv[0];
+    string worker_path = program.substr(0, program.find_last_of('/') + 1) + "MaximumMatchingsWorker";
+    float epsilon = 0.25f;
+    int optimisation_level = 3;
+    int benchmark_passes = 0;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--input" && has_value) input_file = argv[++i];
+        else if (arg == "--workers" && has_value) worker_counts = splitList(argv[++i]);
+        else if (arg == "--worker" && has_value) worker_path = argv[++i];
+        else if (arg == "--epsilon" && has_value) epsilon = stof(argv[++i]);
+        else if (arg == "--optimisation" && has_value) optimisation_level = stoi(argv[++i]);
+        else if (arg == "--pass-benchmark" && has_value) benchmark_passes = stoi(argv[++i]);
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (input_file.empty()) {
+        printUsage();
+        return 1;
+    }
+    if (!ifstream(input_file)) {
+        std::cerr << "Could not read " << input_file << '\n';
+        return 1;
+    }
+    // A worker which stops is reported when its edges run out, rather than ending this process on writing to it.
+    signal(SIGPIPE, SIG_IGN);
+
+    // edges_received counts the edges sent by the workers over the timed passes, which is fewer than edges times
+    // passes once the workers filter the passes which only need the edges between structures.
+    std::cout << "workers,edges,passes,edges_received,wall_time_ms,edges_per_second,matching_size,coordinator_peak_rss_kb\n";
+    for (int number_of_workers : worker_counts) {
+        ShardedStream stream(worker_path, input_file, number_of_workers);
+        // The first pass also waits for the workers to load their shards, so isn't timed.
+        long number_of_edges = countEdges(&stream);
+        int initial_passes = stream.number_of_passes;
+        long initial_edges_received = stream.edges_received;
+
+        long matching_size = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        if (benchmark_passes > 0) {
+            for (int pass = 0; pass < benchmark_passes; pass++) countEdges(&stream);
+        } else {
+            Config config;
+            config.progress_report = NO_OUTPUT;
+            config.optimisation_level = static_cast<OptimisationLevel>(optimisation_level);
+            Matching matching = getMMSSApproxMaximumMatching(&stream, epsilon, config);
+            matching_size = matching.matched_edges.size();
+        }
+        double wall_time_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        int passes = stream.number_of_passes - initial_passes;
+        double edges_per_second = (wall_time_ms > 0) ? number_of_edges * passes / (wall_time_ms / 1000) : 0;
+
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        std::cout << number_of_workers << "," << number_of_edges << "," << passes << ",";
+        std::cout << stream.edges_received - initial_edges_received << "," << wall_time_ms << ",";
+        std::cout << edges_per_second << "," << matching_size << "," << usage.ru_maxrss << '\n';
+        std::cout.flush();
+    }
+
+    return 0;
+}
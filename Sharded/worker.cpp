@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ShardProtocol.h"
+#include "../Stream/EdgeParsing.h"
+
+using namespace std;
+
+// A worker holds one shard of an edge list file, the lines starting within its share of the file's bytes, and streams
+// it to the coordinator over stdout whenever asked over stdin.
+// Usage: MaximumMatchingsWorker FILE SHARD_INDEX SHARD_COUNT
+
+static bool loadShard(string file_name, int shard_index, int shard_count, vector<int32_t>* edges) {
+    ifstream file(file_name, ios::binary | ios::ate);
+    long long file_size = file.tellg();
+    if (!file || file_size < 0) return false;
+    long long start = file_size * shard_index / shard_count;
+    long long end = file_size * (shard_index + 1) / shard_count;
+
+    // Lines belong to the shard their first byte is in, so a line crossing the start is skipped.
+    file.seekg(start);
+    string line;
+    if (start > 0) {
+        file.seekg(start - 1);
+        char previous;
+        file.get(previous);
+        if (previous != '\n') getline(file, line);
+    }
+
+    while (file.tellg() < end && file.tellg() != -1 && getline(file, line)) {
+        int v1, v2;
+        // Skipping unimportant lines
+        if (!parseEdgeLine(line.data(), line.data() + line.size(), &v1, &v2)) continue;
+        edges->emplace_back(v1);
+        edges->emplace_back(v2);
+    }
+    return !file.bad();
+}
+
+static bool sendEdges(const vector<int32_t>& edges) {
+    uint32_t number_of_edges = static_cast<uint32_t>(edges.size() / 2);
+    for (uint32_t first = 0; first < number_of_edges; first += SHARD_BLOCK_EDGES) {
+        uint32_t count = min(SHARD_BLOCK_EDGES, number_of_edges - first);
+        if (!writeFully(STDOUT_FILENO, &count, sizeof(count))) return false;
+        if (!writeFully(STDOUT_FILENO, &edges[2 * first], 2 * count * sizeof(int32_t))) return false;
+    }
+    uint32_t end_of_pass = 0;
+    return writeFully(STDOUT_FILENO, &end_of_pass, sizeof(end_of_pass));
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        std::cerr << "Usage: MaximumMatchingsWorker FILE SHARD_INDEX SHARD_COUNT" << '\n';
+        return 1;
+    }
+
+    vector<int32_t> edges;
+    if (!loadShard(argv[1], stoi(argv[2]), stoi(argv[3]), &edges)) {
+        std::cerr << "Shard worker " << argv[2] << " could not read " << argv[1] << '\n';
+        return 1;
+    }
+    int32_t max_vertex = -1;
+    for (int32_t vertex : edges) {
+        max_vertex = max(max_vertex, vertex);
+    }
+
+    // Marks the vertices of a filtered pass, cleared again once the pass is sent.
+    vector<char> in_filter(max_vertex + 1, 0);
+    vector<int32_t> filter_vertices;
+    vector<int32_t> filtered_edges;
+
+    char command;
+    while (readFully(STDIN_FILENO, &command, 1)) {
+        if (command == SHARD_PASS) {
+            if (!sendEdges(edges)) return 1;
+        } else if (command == SHARD_FILTERED_PASS) {
+            uint32_t number_of_vertices;
+            if (!readFully(STDIN_FILENO, &number_of_vertices, sizeof(number_of_vertices))) return 1;
+            filter_vertices.resize(number_of_vertices);
+            if (!readFully(STDIN_FILENO, filter_vertices.data(), number_of_vertices * sizeof(int32_t))) return 1;
+
+            for (int32_t vertex : filter_vertices) {
+                if (vertex >= 0 && vertex <= max_vertex) in_filter[vertex] = 1;
+            }
+            filtered_edges.clear();
+            for (size_t i = 0; i < edges.size(); i += 2) {
+                int32_t u = edges[i];
+                int32_t v = edges[i + 1];
+                if (u >= 0 && v >= 0 && in_filter[u] && in_filter[v]) {
+                    filtered_edges.emplace_back(u);
+                    filtered_edges.emplace_back(v);
+                }
+            }
+            for (int32_t vertex : filter_vertices) {
+                if (vertex >= 0 && vertex <= max_vertex) in_filter[vertex] = 0;
+            }
+
+            if (!sendEdges(filtered_edges)) return 1;
+        } else {
+            break;
+        }
+    }
+
+    return 0;
+}
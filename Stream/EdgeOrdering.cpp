@@ -0,0 +1,157 @@
+#include "EdgeOrdering.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <queue>
+#include <unordered_map>
+
+// Position of (x, y) along a Hilbert curve filling a 2^order by 2^order grid.
+static uint64_t getHilbertIndex(uint64_t x, uint64_t y, int order) {
+    uint64_t index = 0;
+    for (uint64_t s = uint64_t(1) << (order - 1); s > 0; s /= 2) {
+        uint64_t rx = (x & s) > 0;
+        uint64_t ry = (y & s) > 0;
+        index += s * s * ((3 * rx) ^ ry);
+
+        // Rotating the quadrant so the curve is continuous.
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            swap(x, y);
+        }
+    }
+    return index;
+}
+
+// Reverse Cuthill-McKee position of every vertex. Each component is searched breadth first from one of its lowest
+// degree vertices, visiting neighbours in increasing order of degree.
+static vector<int> getRCMPositions(const vector<pair<int, int>>& arcs, int number_of_vertices) {
+    // Compressed adjacency lists, the arcs already hold both directions of each edge.
+    vector<long> offsets(number_of_vertices + 1, 0);
+    for (pair<int, int> arc : arcs) {
+        offsets[arc.first + 1] += 1;
+    }
+    for (int vertex = 0; vertex < number_of_vertices; vertex++) {
+        offsets[vertex + 1] += offsets[vertex];
+    }
+    vector<int> neighbours(arcs.size());
+    vector<long> next_position(offsets.begin(), offsets.end() - 1);
+    for (pair<int, int> arc : arcs) {
+        neighbours[next_position[arc.first]++] = arc.second;
+    }
+
+    auto degree = [&offsets](int vertex) { return offsets[vertex + 1] - offsets[vertex]; };
+    for (int vertex = 0; vertex < number_of_vertices; vertex++) {
+        sort(neighbours.begin() + offsets[vertex], neighbours.begin() + offsets[vertex + 1], [&degree](int a, int b) {
+            return degree(a) < degree(b);
+        });
+    }
+
+    vector<int> vertices_by_degree(number_of_vertices);
+    for (int vertex = 0; vertex < number_of_vertices; vertex++) {
+        vertices_by_degree[vertex] = vertex;
+    }
+    stable_sort(vertices_by_degree.begin(), vertices_by_degree.end(), [&degree](int a, int b) {
+        return degree(a) < degree(b);
+    });
+
+    vector<int> positions(number_of_vertices, -1);
+    int next = 0;
+    queue<int> to_visit;
+    for (int start : vertices_by_degree) {
+        if (positions[start] != -1) continue;
+        positions[start] = next++;
+        to_visit.push(start);
+        while (! to_visit.empty()) {
+            int vertex = to_visit.front();
+            to_visit.pop();
+            for (long i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+                if (positions[neighbours[i]] == -1) {
+                    positions[neighbours[i]] = next++;
+                    to_visit.push(neighbours[i]);
+                }
+            }
+        }
+    }
+
+    // Reversing the Cuthill-McKee order.
+    for (int& position : positions) {
+        position = number_of_vertices - 1 - position;
+    }
+    return positions;
+}
+
+void reorderArcs(vector<pair<int, int>>* arcs, EdgeOrder order) {
+    if (order == FILE_ORDER || arcs->empty()) return;
+
+    int number_of_vertices = 0;
+    for (pair<int, int> arc : *arcs) {
+        number_of_vertices = max(number_of_vertices, max(arc.first, arc.second) + 1);
+    }
+
+    vector<int> positions;
+    if (order == RCM_ORDER) positions = getRCMPositions(*arcs, number_of_vertices);
+    int curve_order = 1;
+    while ((1LL << curve_order) < number_of_vertices) curve_order++;
+
+    // Sorting the edges by a key computed once per edge, keeping the two arcs of each edge next to each other so the
+    // second always finds its vertices' state in cache.
+    vector<pair<uint64_t, pair<int, int>>> keyed_edges;
+    keyed_edges.reserve(arcs->size() / 2);
+    for (size_t i = 0; i < arcs->size(); i += 2) {
+        pair<int, int> arc = (*arcs)[i];
+        uint64_t low = min(arc.first, arc.second);
+        uint64_t high = max(arc.first, arc.second);
+
+        uint64_t key;
+        if (order == SOURCE_ORDER) {
+            key = (low << 32) | high;
+        } else if (order == RCM_ORDER) {
+            uint64_t first_position = positions[arc.first];
+            uint64_t second_position = positions[arc.second];
+            key = (min(first_position, second_position) << 32) | max(first_position, second_position);
+        } else {
+            key = getHilbertIndex(low, high, curve_order);
+        }
+        keyed_edges.emplace_back(key, arc);
+    }
+
+    sort(keyed_edges.begin(), keyed_edges.end());
+    for (size_t i = 0; i < keyed_edges.size(); i++) {
+        pair<int, int> arc = keyed_edges[i].second;
+        (*arcs)[2 * i] = arc;
+        (*arcs)[2 * i + 1] = make_pair(arc.second, arc.first);
+    }
+}
+
+double getVertexCacheMissRate(const vector<pair<int, int>>& arcs, int cache_vertices) {
+    if (arcs.empty()) return 0;
+
+    // Most recently used vertices at the front.
+    list<int> cached;
+    unordered_map<int, list<int>::iterator> position_in_cache;
+    long misses = 0;
+
+    for (pair<int, int> arc : arcs) {
+        for (int vertex : {arc.first, arc.second}) {
+            auto found = position_in_cache.find(vertex);
+            if (found != position_in_cache.end()) {
+                cached.splice(cached.begin(), cached, found->second);
+                continue;
+            }
+
+            misses += 1;
+            cached.push_front(vertex);
+            position_in_cache[vertex] = cached.begin();
+            if (static_cast<int>(cached.size()) > cache_vertices) {
+                position_in_cache.erase(cached.back());
+                cached.pop_back();
+            }
+        }
+    }
+
+    return static_cast<double>(misses) / (2.0 * arcs.size());
+}
@@ -0,0 +1,25 @@
+#ifndef EDGEORDERING_H
+#define EDGEORDERING_H
+
+#include <vector>
+
+using namespace std;
+
+enum EdgeOrder {
+    FILE_ORDER = 0, // Arcs are kept in the order they were read
+    SOURCE_ORDER = 1, // Arcs are sorted by their first vertex, then their second
+    RCM_ORDER = 2, // Arcs are sorted by the reverse Cuthill-McKee position of their vertices, so neighbouring vertices are close
+    HILBERT_ORDER = 3, // Arcs are sorted along a Hilbert curve through the (u, v) adjacency matrix
+};
+
+// Reorders the arcs of an in-memory stream, which holds the two arcs of each edge next to each other, so that
+// consecutive edges touch the same or recently used vertices, keeping the per vertex state looked up by the engine in
+// cache. Vertices keep their labels, so matchings need no translation. The order changes which edges a greedy initial
+// matching picks, so can change the quality of the result.
+void reorderArcs(vector<pair<int, int>>* arcs, EdgeOrder order);
+
+// Fraction of vertex lookups missing a simulated fully associative LRU cache holding the state of cache_vertices
+// vertices, when reading the arcs in order. Used to compare the locality of orders.
+double getVertexCacheMissRate(const vector<pair<int, int>>& arcs, int cache_vertices);
+
+#endif //EDGEORDERING_H
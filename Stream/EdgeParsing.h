@@ -0,0 +1,33 @@
+#ifndef EDGEPARSING_H
+#define EDGEPARSING_H
+
+using namespace std;
+
+// Parses a number at position, moving position past it. Returns false if there isn't one.
+inline bool parseNumber(const char** position, const char* end, int* number) {
+    const char* current = *position;
+    while (current < end && (*current == ' ' || *current == '\t')) current++;
+
+    bool negative = current < end && *current == '-';
+    if (negative) current++;
+    if (current == end || *current < '0' || *current > '9') return false;
+
+    long value = 0;
+    while (current < end && *current >= '0' && *current <= '9') {
+        value = value * 10 + (*current - '0');
+        current++;
+    }
+
+    *number = static_cast<int>(negative ? -value : value);
+    *position = current;
+    return true;
+}
+
+// Parses a line "u v" of an edge list into its two vertices. Returns false for empty and comment ('#') lines, along with
+// any line which doesn't start with two vertices.
+inline bool parseEdgeLine(const char* line, const char* end, int* v1, int* v2) {
+    if (line == end || *line == '#') return false;
+    return parseNumber(&line, end, v1) && parseNumber(&line, end, v2);
+}
+
+#endif //EDGEPARSING_H
@@ -0,0 +1,51 @@
+#include "PermutedStream.h"
+
+static uint64_t greatestCommonDivisor(uint64_t a, uint64_t b) {
+    while (b != 0) {
+        uint64_t remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
+
+static uint64_t splitMix64(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+PermutedStream::PermutedStream(const vector<pair<int, int>>* edges, uint64_t seed) {
+    this->edges = edges;
+    number_of_passes = 0;
+
+    uint64_t m = edges->size();
+    if (seed == 0 || m < 2) return;
+
+    multiplier = splitMix64(seed) % m;
+    while (multiplier == 0 || greatestCommonDivisor(multiplier, m) != 1) {
+        multiplier = (multiplier + 1) % m;
+    }
+    offset = splitMix64(seed ^ 0x5bd1e995ULL) % m;
+}
+
+pair<int, int> PermutedStream::readStream() {
+    if (position >= edges->size()) {
+        number_of_passes += 1;
+        position = 0;
+        return make_pair(-1, -1);
+    }
+
+    // The multiplier and position are both below m, so the product fits in 64 bits for arrays of under 2^32 edges.
+    pair<int, int> edge = (*edges)[(multiplier * position + offset) % edges->size()];
+
+    // Returning both arcs of each edge, the second arc on the following call.
+    if (show_last_edge) {
+        show_last_edge = false;
+        position++;
+        return make_pair(edge.second, edge.first);
+    }
+    show_last_edge = true;
+    return edge;
+}
@@ -0,0 +1,27 @@
+#ifndef PERMUTEDSTREAM_H
+#define PERMUTEDSTREAM_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Stream.h"
+
+using namespace std;
+
+// Streams a shared in-memory edge array in a deterministic pseudo-random order, without copying it. Edge i of the
+// stream is edge (multiplier * i + offset) mod m of the array, where the multiplier is coprime to m so every edge is
+// read exactly once per pass. Seed 0 keeps the original order.
+class PermutedStream : public Stream {
+    private:
+        const vector<pair<int, int>>* edges;
+        uint64_t multiplier = 1;
+        uint64_t offset = 0;
+        uint64_t position = 0;
+        bool show_last_edge = false;
+
+    public:
+        PermutedStream(const vector<pair<int, int>>* edges, uint64_t seed);
+        pair<int, int> readStream() override;
+};
+
+#endif //PERMUTEDSTREAM_H
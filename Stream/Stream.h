@@ -2,6 +2,7 @@
 #define STREAM_H
 
 #include <fstream>
+#include <vector>
 
 using namespace std;
 
@@ -12,6 +13,10 @@ class Stream {
     public:
         virtual ~Stream(void){};
         virtual pair<int, int> readStream() = 0;
+        // Streams which can drop edges before they are read, such as those fed by other processes, may restrict the
+        // next pass to the edges with both vertices in the given set. Every other edge may then be left out of the pass.
+        virtual bool canRestrictPasses() const { return false; }
+        virtual void restrictNextPass(const vector<int>& /*vertices*/) {}
 };
 
 #endif
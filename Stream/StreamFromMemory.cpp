@@ -1,32 +1,123 @@
 #include "StreamFromMemory.h"
 
-StreamFromMemory::StreamFromMemory(string file_name) {
-    number_of_passes = 0;
+#include <algorithm>
+#include <thread>
 
-    ifstream file = ifstream(file_name);
+#include "EdgeParsing.h"
 
-    string line;
+// Files smaller than this are parsed on a single thread, as starting threads would take longer than parsing.
+static const long long MIN_BYTES_PER_THREAD = 1 << 20;
+static const size_t READ_BUFFER_SIZE = 1 << 20;
 
-    while(getline(file, line)) {
-        // Skipping unimportant lines
-        if (line.empty()) {
-            continue;
-        }
-        if (line[0] == '#') {
-            continue;
+// Parses the edges on the lines starting within [start, end) of the file. A line belongs to the range its first byte is
+// in, so ranges can be split anywhere and every line is still parsed exactly once.
+static void parseByteRange(string file_name, long long start, long long end, vector<pair<int, int>>* edges) {
+    ifstream file = ifstream(file_name, ios::binary);
+    file.seekg(start);
+
+    // Position in the file of the first byte in buffer.
+    long long buffer_start = start;
+    string buffer;
+    // A range starting part way through a line skips to the start of the next line.
+    bool skipping_line = false;
+    if (start > 0) {
+        file.seekg(start - 1);
+        buffer_start = start - 1;
+        skipping_line = true;
+    }
+
+    vector<char> read_buffer(READ_BUFFER_SIZE);
+    bool end_of_file = false;
+    while (! end_of_file) {
+        file.read(read_buffer.data(), read_buffer.size());
+        end_of_file = file.gcount() < static_cast<streamsize>(read_buffer.size());
+        buffer.append(read_buffer.data(), file.gcount());
+
+        size_t line_start = 0;
+        while (true) {
+            size_t line_end = buffer.find('\n', line_start);
+            // The last line of the file may not end in a newline.
+            if (line_end == string::npos) {
+                if (! end_of_file || line_start == buffer.size()) break;
+                line_end = buffer.size();
+            }
+
+            if (buffer_start + static_cast<long long>(line_start) >= end) return;
+
+            if (skipping_line) {
+                skipping_line = false;
+            } else {
+                // Skipping unimportant lines
+                int v1, v2;
+                if (parseEdgeLine(buffer.data() + line_start, buffer.data() + line_end, &v1, &v2)) {
+                    edges->emplace_back(v1, v2);
+                }
+            }
+            line_start = line_end + 1;
+            if (line_start > buffer.size()) break;
         }
 
-        // Splitting string by the " "
-        int deliminter_position = line.find_first_of(" ");
-        string v1_text = line.substr(0, deliminter_position);
-        string v2_text = line.substr(deliminter_position + 1, line.length());
+        // Keeping the incomplete last line for the next read.
+        line_start = min(line_start, buffer.size());
+        buffer.erase(0, line_start);
+        buffer_start += line_start;
+    }
+}
+
+StreamFromMemory::StreamFromMemory(string file_name, int threads) {
+    number_of_passes = 0;
+
+    ifstream file = ifstream(file_name, ios::binary | ios::ate);
+    long long file_size = file ? static_cast<long long>(file.tellg()) : 0;
+    file.close();
+
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    threads = static_cast<int>(max(1LL, min(static_cast<long long>(threads), file_size / MIN_BYTES_PER_THREAD)));
 
-        int v1 = stoi(v1_text);
-        int v2 = stoi(v2_text);
+    // Each thread parses a share of the file's bytes into its own list of edges.
+    vector<vector<pair<int, int>>> thread_edges(threads);
+    vector<thread> parsers;
+    for (int i = 0; i < threads; i++) {
+        long long start = file_size * i / threads;
+        long long end = file_size * (i + 1) / threads;
+        parsers.emplace_back(parseByteRange, file_name, start, end, &thread_edges[i]);
+    }
+    for (thread& parser : parsers) {
+        parser.join();
+    }
+
+    // Assembling the lists in file order into a single array sized up front, storing both arcs of each edge. Each list
+    // is copied and freed by its own thread.
+    vector<size_t> offsets(threads + 1, 0);
+    for (int i = 0; i < threads; i++) {
+        offsets[i + 1] = offsets[i] + 2 * thread_edges[i].size();
+    }
+    lines.resize(offsets[threads]);
+
+    parsers.clear();
+    for (int i = 0; i < threads; i++) {
+        parsers.emplace_back([this, &thread_edges, &offsets, i]() {
+            size_t position = offsets[i];
+            for (pair<int, int> edge : thread_edges[i]) {
+                lines[position++] = edge;
+                lines[position++] = make_pair(edge.second, edge.first);
+            }
+            vector<pair<int, int>>().swap(thread_edges[i]);
+        });
+    }
+    for (thread& parser : parsers) {
+        parser.join();
+    }
+}
+
+StreamFromMemory::StreamFromMemory(const vector<pair<int, int>>& edges) {
+    number_of_passes = 0;
 
-        lines.push_back(make_pair(v1, v2));
-        // TODO: testing both arcs?
-        lines.push_back(make_pair(v2, v1));
+    // Storing both arcs of each edge, as is done when reading from a file.
+    lines.reserve(2 * edges.size());
+    for (pair<int, int> edge : edges) {
+        lines.push_back(edge);
+        lines.push_back(make_pair(edge.second, edge.first));
     }
 }
 
@@ -42,3 +133,11 @@ pair<int, int> StreamFromMemory::readStream() {
     line_number++;
     return edge;
 }
+
+void StreamFromMemory::reorder(EdgeOrder order) {
+    reorderArcs(&lines, order);
+}
+
+double StreamFromMemory::getVertexCacheMissRate(int cache_vertices) const {
+    return ::getVertexCacheMissRate(lines, cache_vertices);
+}
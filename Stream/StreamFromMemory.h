@@ -1,5 +1,9 @@
 #ifndef STREAMFROMMEMORY_H
 #define STREAMFROMMEMORY_H
+#include <string>
+#include <vector>
+
+#include "EdgeOrdering.h"
 #include "Stream.h"
 
 class StreamFromMemory : public Stream {
@@ -7,8 +11,14 @@ class StreamFromMemory : public Stream {
     vector<pair<int, int>> lines = {};
 
     public:
-        explicit StreamFromMemory(string file_name);
+        // Files are parsed on the given number of threads, each taking a share of the file's bytes. With 0 threads, one
+        // is used per hardware thread.
+        explicit StreamFromMemory(string file_name, int threads = 0);
+        explicit StreamFromMemory(const vector<pair<int, int>>& edges);
         pair<int, int> readStream() override;
+        // Reorders the arcs for locality, see EdgeOrdering.h. Must be called between passes.
+        void reorder(EdgeOrder order);
+        double getVertexCacheMissRate(int cache_vertices) const;
 
 };
 
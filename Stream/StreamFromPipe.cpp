@@ -0,0 +1,155 @@
+#include "StreamFromPipe.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "EdgeParsing.h"
+
+static const size_t READ_BUFFER_SIZE = 1 << 16;
+// Number of vertices written to the spool file at a time.
+static const size_t SPOOL_BUFFER_VERTICES = 1 << 16;
+
+StreamFromPipe::StreamFromPipe(int input_fd, string spool_file_name) {
+    number_of_passes = 0;
+    this->input_fd = input_fd;
+    // A new file is always created, so an existing file or a link planted at the path is never written through.
+    if (spool_file_name.empty()) {
+        const char* temporary_directory = getenv("TMPDIR");
+        string directory = (temporary_directory != nullptr && temporary_directory[0] != '\0') ? temporary_directory : "/tmp";
+        vector<char> file_template(directory.begin(), directory.end());
+        string suffix = "/MaximumMatchings.XXXXXX";
+        file_template.insert(file_template.end(), suffix.begin(), suffix.end());
+        file_template.emplace_back('\0');
+
+        spool_fd = mkstemp(file_template.data());
+        spool_file_name = file_template.data();
+    } else {
+        spool_fd = open(spool_file_name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+    }
+    this->spool_file_name = spool_file_name;
+    // Without the spool file every pass after the first would be empty, so the run can't go ahead.
+    if (spool_fd == -1) throw runtime_error("Could not create the spool file " + spool_file_name);
+    spool_created = true;
+    spool_buffer.reserve(SPOOL_BUFFER_VERTICES);
+}
+
+StreamFromPipe::~StreamFromPipe() {
+    if (spool_fd != -1) close(spool_fd);
+    if (spooled_edges != nullptr) munmap(const_cast<int32_t*>(spooled_edges), spool_size);
+    if (spool_created) unlink(spool_file_name.c_str());
+}
+
+bool StreamFromPipe::readEdgeFromInput(pair<int, int>* edge) {
+    while (true) {
+        size_t line_end = input_buffer.find('\n', input_position);
+
+        if (line_end == string::npos && ! end_of_input) {
+            // Keeping the incomplete last line and reading more of the input.
+            input_buffer.erase(0, input_position);
+            input_position = 0;
+
+            char read_buffer[READ_BUFFER_SIZE];
+            ssize_t bytes_read = read(input_fd, read_buffer, READ_BUFFER_SIZE);
+            if (bytes_read <= 0) end_of_input = true;
+            else input_buffer.append(read_buffer, bytes_read);
+            continue;
+        }
+
+        // The last line of the input may not end in a newline.
+        if (line_end == string::npos) {
+            if (input_position >= input_buffer.size()) return false;
+            line_end = input_buffer.size();
+        }
+
+        const char* line = input_buffer.data() + input_position;
+        const char* end = input_buffer.data() + line_end;
+        input_position = line_end + 1;
+
+        // Skipping unimportant lines
+        if (parseEdgeLine(line, end, &edge->first, &edge->second)) return true;
+    }
+}
+
+void StreamFromPipe::failSpooling(string message) {
+    /* A spool file missing any edges would silently drop them from every later pass, so the stream is abandoned. */
+    if (spool_fd != -1) close(spool_fd);
+    spool_fd = -1;
+    unlink(spool_file_name.c_str());
+    spool_created = false;
+    throw runtime_error(message + " " + spool_file_name);
+}
+
+void StreamFromPipe::flushSpoolBuffer() {
+    const char* data = reinterpret_cast<const char*>(spool_buffer.data());
+    size_t bytes_left = spool_buffer.size() * sizeof(int32_t);
+    while (bytes_left > 0) {
+        ssize_t bytes_written = write(spool_fd, data, bytes_left);
+        if (bytes_written < 0 && errno == EINTR) continue;
+        if (bytes_written <= 0) failSpooling("Could not write to the spool file");
+        data += bytes_written;
+        bytes_left -= bytes_written;
+    }
+    spool_buffer.clear();
+}
+
+void StreamFromPipe::finishSpooling() {
+    /* Closes the spool file once the input has been read, mapping it into memory for the later passes. */
+    flushSpoolBuffer();
+    spooling = false;
+
+    // The file is mapped through the descriptor it was written with, rather than opened again by name.
+    spool_size = lseek(spool_fd, 0, SEEK_END);
+    if (spool_size == 0) {
+        close(spool_fd);
+        spool_fd = -1;
+        return;
+    }
+    void* mapping = mmap(nullptr, spool_size, PROT_READ, MAP_PRIVATE, spool_fd, 0);
+    if (mapping == MAP_FAILED) failSpooling("Could not map the spool file");
+    close(spool_fd);
+    spool_fd = -1;
+
+    // Every later pass reads the spool file from start to end.
+    madvise(mapping, spool_size, MADV_SEQUENTIAL);
+    spooled_edges = static_cast<const int32_t*>(mapping);
+    number_of_edges = spool_size / (2 * sizeof(int32_t));
+}
+
+pair<int, int> StreamFromPipe::readStream() {
+    // Returning the second arc of the edge.
+    if (show_last_edge) {
+        show_last_edge = false;
+        return last_edge;
+    }
+
+    pair<int, int> edge;
+    if (spooling) {
+        if (! readEdgeFromInput(&edge)) {
+            finishSpooling();
+            number_of_passes += 1;
+            return make_pair(-1, -1);
+        }
+
+        spool_buffer.emplace_back(edge.first);
+        spool_buffer.emplace_back(edge.second);
+        if (spool_buffer.size() >= SPOOL_BUFFER_VERTICES) flushSpoolBuffer();
+    } else {
+        // Occurs when we are at the end of the stream.
+        if (edge_number >= number_of_edges) {
+            edge_number = 0;
+            number_of_passes += 1;
+            return make_pair(-1, -1);
+        }
+
+        edge = make_pair(spooled_edges[2 * edge_number], spooled_edges[2 * edge_number + 1]);
+        edge_number += 1;
+    }
+
+    last_edge = make_pair(edge.second, edge.first);
+    show_last_edge = true;
+    return edge;
+}
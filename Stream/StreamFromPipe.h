@@ -0,0 +1,53 @@
+#ifndef STREAMFROMPIPE_H
+#define STREAMFROMPIPE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Stream.h"
+
+using namespace std;
+
+// Streams an edge list from a pipe or stdin, which can only be read once. The first pass parses the input as it arrives,
+// writing each edge to a binary spool file, a pair of int32 vertices per edge, and later passes read the spool file
+// through mmap. An empty spool file name creates a unique file in $TMPDIR, or /tmp if it isn't set, otherwise the named
+// file must not already exist. The spool file is deleted when the stream is destroyed. Throws runtime_error if the spool
+// file can't be created, written or mapped, as the later passes would otherwise be missing edges.
+class StreamFromPipe : public Stream {
+    private:
+        int input_fd;
+        string spool_file_name;
+
+        // First pass
+        bool spooling = true;
+        int spool_fd = -1;
+        // Set once the spool file has been created, so only a file made by the stream is ever deleted.
+        bool spool_created = false;
+        string input_buffer;
+        size_t input_position = 0;
+        bool end_of_input = false;
+        vector<int32_t> spool_buffer;
+
+        // Later passes
+        const int32_t* spooled_edges = nullptr;
+        size_t spool_size = 0;
+        size_t number_of_edges = 0;
+        size_t edge_number = 0;
+
+        pair<int, int> last_edge = make_pair(-1, -1);
+        bool show_last_edge = false;
+
+    public:
+        StreamFromPipe(int input_fd, string spool_file_name);
+        ~StreamFromPipe() override;
+        pair<int, int> readStream() override;
+    private:
+        bool readEdgeFromInput(pair<int, int>* edge);
+        void flushSpoolBuffer();
+        // Deletes the spool file and throws, naming the file after the message.
+        void failSpooling(string message);
+        void finishSpooling();
+};
+
+#endif //STREAMFROMPIPE_H
@@ -0,0 +1,21 @@
+#ifndef TIMESTAMPEDSTREAM_H
+#define TIMESTAMPEDSTREAM_H
+
+#include "Stream.h"
+
+using namespace std;
+
+struct TimestampedEdge {
+    pair<int, int> edge;
+    double timestamp;
+};
+
+// A stream of edges in non-decreasing timestamp order. readStream() returns both arcs of each edge without their
+// timestamps, so the stream can still be used by the rest of the engine, whereas readTimestampedStream() returns each
+// edge once with its timestamp. Both return the edge (-1, -1) at the end of the stream.
+class TimestampedStream : public Stream {
+    public:
+        virtual TimestampedEdge readTimestampedStream() = 0;
+};
+
+#endif //TIMESTAMPEDSTREAM_H
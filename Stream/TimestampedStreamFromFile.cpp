@@ -0,0 +1,52 @@
+#include "TimestampedStreamFromFile.h"
+
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+TimestampedStreamFromFile::TimestampedStreamFromFile(string file_name) {
+    file = ifstream(file_name);
+    number_of_passes = 0;
+}
+
+TimestampedEdge TimestampedStreamFromFile::readTimestampedStream() {
+    string line;
+
+    // Occurs when we are at the end of the stream.
+    if (! getline(file, line)) {
+
+        // Returning to the beginning of the file in preparation for the next pass
+        file.clear();
+        file.seekg(0, ios::beg);
+
+        number_of_passes += 1;
+
+        // -1 will represent the fact that we have reached the end of the stream.
+        return {make_pair(-1, -1), 0};
+    }
+
+    // Skipping empty lines and comments
+    if (line.empty() || line[0] == '#') {
+        return readTimestampedStream();
+    }
+
+    TimestampedEdge timestamped_edge;
+    istringstream(line) >> timestamped_edge.edge.first >> timestamped_edge.edge.second >> timestamped_edge.timestamp;
+    return timestamped_edge;
+}
+
+pair<int, int> TimestampedStreamFromFile::readStream() {
+    // Returning the second arc of the edge.
+    if (show_last_edge) {
+        show_last_edge = false;
+        return last_edge;
+    }
+
+    pair<int, int> edge = readTimestampedStream().edge;
+    if (edge.first != -1) {
+        last_edge = make_pair(edge.second, edge.first);
+        show_last_edge = true;
+    }
+    return edge;
+}
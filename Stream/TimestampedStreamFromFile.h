@@ -0,0 +1,21 @@
+#ifndef TIMESTAMPEDSTREAMFROMFILE_H
+#define TIMESTAMPEDSTREAMFROMFILE_H
+
+#include "TimestampedStream.h"
+
+using namespace std;
+
+// Reads edges from a file with a line "u v timestamp" per edge.
+class TimestampedStreamFromFile : public TimestampedStream {
+    private:
+        pair<int,int> last_edge = make_pair(-1,-1);
+        bool show_last_edge = false;
+        ifstream file{};
+
+    public:
+        explicit TimestampedStreamFromFile(string file_name);
+        pair<int, int> readStream() override;
+        TimestampedEdge readTimestampedStream() override;
+};
+
+#endif //TIMESTAMPEDSTREAMFROMFILE_H
@@ -0,0 +1,30 @@
+#include "WeightClassStream.h"
+
+WeightClassStream::WeightClassStream(WeightedStream* weighted_stream, double min_weight) {
+    this->weighted_stream = weighted_stream;
+    this->min_weight = min_weight;
+    number_of_passes = 0;
+}
+
+pair<int, int> WeightClassStream::readStream() {
+    // Returning the second arc of the edge.
+    if (show_last_edge) {
+        show_last_edge = false;
+        return last_edge;
+    }
+
+    // Skipping edges lighter than the class.
+    WeightedEdge weighted_edge = weighted_stream->readWeightedStream();
+    while (weighted_edge.edge.first != -1 && weighted_edge.weight < min_weight) {
+        weighted_edge = weighted_stream->readWeightedStream();
+    }
+
+    if (weighted_edge.edge.first == -1) {
+        number_of_passes += 1;
+        return make_pair(-1, -1);
+    }
+
+    last_edge = make_pair(weighted_edge.edge.second, weighted_edge.edge.first);
+    show_last_edge = true;
+    return weighted_edge.edge;
+}
@@ -0,0 +1,22 @@
+#ifndef WEIGHTCLASSSTREAM_H
+#define WEIGHTCLASSSTREAM_H
+
+#include "WeightedStream.h"
+
+using namespace std;
+
+// Streams both arcs of the edges of a weighted stream with weight at least min_weight, so the unweighted engine can be
+// run on a single weight class. Each pass of this stream is a pass of the underlying stream.
+class WeightClassStream : public Stream {
+    private:
+        WeightedStream* weighted_stream;
+        double min_weight;
+        pair<int, int> last_edge = make_pair(-1, -1);
+        bool show_last_edge = false;
+
+    public:
+        WeightClassStream(WeightedStream* weighted_stream, double min_weight);
+        pair<int, int> readStream() override;
+};
+
+#endif //WEIGHTCLASSSTREAM_H
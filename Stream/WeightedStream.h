@@ -0,0 +1,21 @@
+#ifndef WEIGHTEDSTREAM_H
+#define WEIGHTEDSTREAM_H
+
+#include "Stream.h"
+
+using namespace std;
+
+struct WeightedEdge {
+    pair<int, int> edge;
+    double weight;
+};
+
+// A stream of weighted edges. readStream() returns both arcs of each edge without their weights, so the stream can
+// still be used by the rest of the engine, whereas readWeightedStream() returns each edge once with its weight. Both
+// return the edge (-1, -1) at the end of a pass.
+class WeightedStream : public Stream {
+    public:
+        virtual WeightedEdge readWeightedStream() = 0;
+};
+
+#endif //WEIGHTEDSTREAM_H
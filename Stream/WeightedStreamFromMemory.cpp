@@ -0,0 +1,53 @@
+#include "WeightedStreamFromMemory.h"
+
+#include <sstream>
+
+WeightedStreamFromMemory::WeightedStreamFromMemory(string file_name) {
+    number_of_passes = 0;
+
+    ifstream file = ifstream(file_name);
+
+    string line;
+
+    while(getline(file, line)) {
+        // Skipping unimportant lines
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        WeightedEdge weighted_edge;
+        weighted_edge.weight = 1;
+        istringstream(line) >> weighted_edge.edge.first >> weighted_edge.edge.second >> weighted_edge.weight;
+        lines.push_back(weighted_edge);
+    }
+}
+
+WeightedStreamFromMemory::WeightedStreamFromMemory(const vector<WeightedEdge>& edges) {
+    number_of_passes = 0;
+    lines = edges;
+}
+
+WeightedEdge WeightedStreamFromMemory::readWeightedStream() {
+    if (line_number >= lines.size()) {
+        number_of_passes += 1;
+        line_number = 0;
+        return {make_pair(-1, -1), 0};
+    }
+
+    WeightedEdge weighted_edge = lines.at(line_number);
+    line_number++;
+    return weighted_edge;
+}
+
+pair<int, int> WeightedStreamFromMemory::readStream() {
+    // Returning the second arc of the previous edge.
+    if (show_last_edge) {
+        show_last_edge = false;
+        pair<int, int> edge = lines.at(line_number - 1).edge;
+        return make_pair(edge.second, edge.first);
+    }
+
+    pair<int, int> edge = readWeightedStream().edge;
+    if (edge.first != -1) show_last_edge = true;
+    return edge;
+}
@@ -0,0 +1,22 @@
+#ifndef WEIGHTEDSTREAMFROMMEMORY_H
+#define WEIGHTEDSTREAMFROMMEMORY_H
+
+#include <string>
+#include <vector>
+
+#include "WeightedStream.h"
+
+// Reads edges from a file with a line "u v weight" per edge, edges without a weight are given weight 1.
+class WeightedStreamFromMemory : public WeightedStream {
+    int line_number = 0;
+    bool show_last_edge = false;
+    vector<WeightedEdge> lines = {};
+
+    public:
+        explicit WeightedStreamFromMemory(string file_name);
+        explicit WeightedStreamFromMemory(const vector<WeightedEdge>& edges);
+        pair<int, int> readStream() override;
+        WeightedEdge readWeightedStream() override;
+};
+
+#endif //WEIGHTEDSTREAMFROMMEMORY_H
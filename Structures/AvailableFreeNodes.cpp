@@ -83,6 +83,14 @@ FreeNodeStructure* AvailableFreeNodes::createNewStruct(GraphVertex* vertex) {
     return new_struct;
 }
 
+vector<Vertex> AvailableFreeNodes::getVerticesInLiveStructures() const {
+    vector<Vertex> vertices;
+    for (const pair<const Vertex, FreeNodeStructure*>& entry : vertex_to_struct) {
+        if (entry.second != nullptr && ! entry.second->removed) vertices.emplace_back(entry.first);
+    }
+    return vertices;
+}
+
 void AvailableFreeNodes::deleteStructures() const {
     for (FreeNodeStructure* free_node : free_node_structures) {
         free_node->deleteStructure();
@@ -22,6 +22,8 @@ class AvailableFreeNodes {
         void removeNodeFromStruct(GraphNode* node, FreeNodeStructure* structure);
         void addNodeToStruct(GraphNode* node, GraphNode* main_node, FreeNodeStructure* structure);
         FreeNodeStructure* createNewStruct(GraphVertex* vertex);
+        // Every vertex in a structure which hasn't been removed.
+        vector<Vertex> getVerticesInLiveStructures() const;
         void deleteStructures() const;
     private:
         void removeBlossomFromStruct(GraphBlossom* blossom, FreeNodeStructure* structure);
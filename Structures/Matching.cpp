@@ -85,7 +85,7 @@ void Matching::resetLabels() {
     }
 }
 
-void Matching::verifyMatching() {
+void Matching::verifyMatching(bool report_size) {
     set<Vertex> used_vertices = {};
     for (Edge edge : matched_edges) {
         if (used_vertices.find(edge.first) != used_vertices.end()) {
@@ -101,7 +101,7 @@ void Matching::verifyMatching() {
         used_vertices.insert(edge.second);
     }
 
-    std::cout << "Matching verified, size: " << matched_edges.size() << std::endl;
+    if (report_size) std::cout << "Matching verified, size: " << matched_edges.size() << '\n';
 }
 
 
@@ -110,6 +110,6 @@ std::ostream &operator<<(std::ostream &os, Matching &matching) {
     for (Edge edge : matching.matched_edges) {
         os << "\n\t(" << edge.first << "->" << edge.second << ") : " << matching.getLabel(edge);
     }
-    os << "\nMatching size: " << matching.matched_edges.size() << std::endl;
+    os << "\nMatching size: " << matching.matched_edges.size() << '\n';
     return os;
 }
\ No newline at end of file
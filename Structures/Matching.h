@@ -1,6 +1,8 @@
 #ifndef MATCHING_H
 #define MATCHING_H
 
+#include <unordered_map>
+
 #include "../types.h"
 
 class Matching {
@@ -22,7 +24,7 @@ class Matching {
         Edge getMatchedEdgeFromVertex(Vertex vertex);
         int getLabel(Edge edge);
         void setLabel(Edge edge, int label);
-        void verifyMatching();
+        void verifyMatching(bool report_size = true);
         friend std::ostream &operator<<(std::ostream &os, Matching &matching);
     private:
         Edge getStandardEdge(Edge edge);
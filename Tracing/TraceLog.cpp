@@ -0,0 +1,148 @@
+#include "TraceLog.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+TraceLog::TraceLog(string file_name) {
+    file = ofstream(file_name, ios::binary | ios::trunc);
+    start_time = chrono::steady_clock::now();
+    active_buffer.reserve(BUFFER_SIZE);
+
+    // All file output happens on the writer thread so that recording an event never waits on I/O.
+    writer = thread(&TraceLog::writeBuffers, this);
+}
+
+TraceLog::~TraceLog() {
+    close();
+}
+
+void TraceLog::record(TraceEventType type, int first_id, int second_id, Edge edge) {
+    TraceEvent event;
+    event.timestamp_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start_time).count();
+    event.first_id = first_id;
+    event.second_id = second_id;
+    event.edge_u = edge.first;
+    event.edge_v = edge.second;
+    event.type = type;
+    fill(begin(event.padding), end(event.padding), 0);
+
+    active_buffer.emplace_back(event);
+    if (active_buffer.size() >= BUFFER_SIZE) {
+        flushActiveBuffer();
+    }
+}
+
+void TraceLog::flushActiveBuffer() {
+    if (active_buffer.empty()) {
+        return;
+    }
+
+    unique_lock<mutex> lock(buffers_mutex);
+    full_buffers.emplace_back(move(active_buffer));
+
+    // Reusing a buffer the writer has finished with if there is one, to avoid reallocating.
+    if (!empty_buffers.empty()) {
+        active_buffer = move(empty_buffers.back());
+        empty_buffers.pop_back();
+    } else {
+        active_buffer = vector<TraceEvent>();
+        active_buffer.reserve(BUFFER_SIZE);
+    }
+    lock.unlock();
+
+    buffers_changed.notify_one();
+}
+
+void TraceLog::writeBuffers() {
+    unique_lock<mutex> lock(buffers_mutex);
+    while (true) {
+        buffers_changed.wait(lock, [this] { return closed || !full_buffers.empty(); });
+
+        if (full_buffers.empty() && closed) {
+            break;
+        }
+
+        vector<vector<TraceEvent>> to_write = move(full_buffers);
+        full_buffers.clear();
+        lock.unlock();
+
+        for (vector<TraceEvent>& buffer : to_write) {
+            file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(TraceEvent));
+            buffer.clear();
+        }
+
+        lock.lock();
+        for (vector<TraceEvent>& buffer : to_write) {
+            empty_buffers.emplace_back(move(buffer));
+        }
+    }
+
+    file.flush();
+}
+
+void TraceLog::close() {
+    if (!writer.joinable()) {
+        return;
+    }
+
+    flushActiveBuffer();
+    {
+        lock_guard<mutex> lock(buffers_mutex);
+        closed = true;
+    }
+    buffers_changed.notify_one();
+    writer.join();
+    file.close();
+}
+
+void TraceLog::convertToChromeTrace(string trace_file_name, string json_file_name) {
+    /* Converts a binary trace into the Chrome trace event JSON format, viewable in chrome://tracing or Perfetto. */
+    static const char* event_names[] = {
+        "Scale", "Scale", "Phase", "Phase", "Pass bundle", "Pass bundle",
+        "Overtake Case 1", "Overtake Case 2.1", "Overtake Case 2.2",
+        "Contract", "Augment", "Backtrack", "Phase Skip", "Scale Skip", "Algorithm Skip",
+        "Exact Finish",
+    };
+
+    ifstream trace_file = ifstream(trace_file_name, ios::binary);
+    ofstream json_file = ofstream(json_file_name, ios::trunc);
+
+    json_file << fixed << setprecision(3);
+    json_file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    TraceEvent event;
+    bool first_event = true;
+    while (trace_file.read(reinterpret_cast<char*>(&event), sizeof(TraceEvent))) {
+        if (event.type > TRACE_EXACT_FINISH) {
+            std::cerr << "Unknown trace event type " << static_cast<int>(event.type) << ", stopping conversion." << '\n';
+            break;
+        }
+
+        if (!first_event) json_file << ",";
+        first_event = false;
+
+        // The Chrome format uses microseconds, with fractional values allowed.
+        json_file << "\n{\"name\":\"" << event_names[event.type] << "\",\"pid\":1,\"tid\":1,\"ts\":" << (event.timestamp_ns / 1000.0);
+
+        switch (event.type) {
+            case TRACE_SCALE_BEGIN:
+            case TRACE_PHASE_BEGIN:
+            case TRACE_PASS_BUNDLE_BEGIN:
+                json_file << ",\"ph\":\"B\",\"args\":{\"index\":" << event.first_id << "}}";
+                break;
+            case TRACE_SCALE_END:
+            case TRACE_PHASE_END:
+            case TRACE_PASS_BUNDLE_END:
+                json_file << ",\"ph\":\"E\"}";
+                break;
+            default:
+                json_file << ",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"struct\":" << event.first_id;
+                if (event.second_id != -1) json_file << ",\"other_struct\":" << event.second_id;
+                if (event.edge_u != -1) json_file << ",\"edge\":\"" << event.edge_u << "->" << event.edge_v << "\"";
+                json_file << "}}";
+        }
+    }
+
+    json_file << "\n]}\n";
+}
@@ -0,0 +1,78 @@
+#ifndef TRACELOG_H
+#define TRACELOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../types.h"
+
+using namespace std;
+
+enum TraceEventType : uint8_t {
+    TRACE_SCALE_BEGIN = 0,
+    TRACE_SCALE_END = 1,
+    TRACE_PHASE_BEGIN = 2,
+    TRACE_PHASE_END = 3,
+    TRACE_PASS_BUNDLE_BEGIN = 4,
+    TRACE_PASS_BUNDLE_END = 5,
+    TRACE_OVERTAKE_CASE_1 = 6,
+    TRACE_OVERTAKE_CASE_2_1 = 7,
+    TRACE_OVERTAKE_CASE_2_2 = 8,
+    TRACE_CONTRACT = 9,
+    TRACE_AUGMENT = 10,
+    TRACE_BACKTRACK = 11,
+    TRACE_PHASE_SKIP = 12,
+    TRACE_SCALE_SKIP = 13,
+    TRACE_ALG_SKIP = 14,
+    TRACE_EXACT_FINISH = 15,
+};
+
+// A single fixed size record, written to the trace file exactly as it is laid out in memory.
+// For operations first_id and second_id hold the root vertex of the structures involved, for the
+// scale/phase/pass bundle events first_id holds the index of the scale/phase/pass bundle.
+struct TraceEvent {
+    int64_t timestamp_ns;
+    int32_t first_id;
+    int32_t second_id;
+    int32_t edge_u;
+    int32_t edge_v;
+    uint8_t type;
+    uint8_t padding[7];
+};
+
+class TraceLog {
+    // Variables
+    private:
+        // Number of events held in a buffer before it is handed to the writer thread.
+        static const size_t BUFFER_SIZE = 1 << 16;
+
+        chrono::steady_clock::time_point start_time;
+        vector<TraceEvent> active_buffer;
+        // Buffers waiting to be written, and empty buffers which can be reused by the engine.
+        vector<vector<TraceEvent>> full_buffers;
+        vector<vector<TraceEvent>> empty_buffers;
+        mutex buffers_mutex;
+        condition_variable buffers_changed;
+        bool closed = false;
+        ofstream file;
+        thread writer;
+
+    // Functions
+    public:
+        explicit TraceLog(string file_name);
+        ~TraceLog();
+        void record(TraceEventType type, int first_id = -1, int second_id = -1, Edge edge = make_pair(-1, -1));
+        void close();
+        static void convertToChromeTrace(string trace_file_name, string json_file_name);
+    private:
+        void flushActiveBuffer();
+        void writeBuffers();
+};
+
+#endif //TRACELOG_H
@@ -0,0 +1,101 @@
+#include "WeightedMatching.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../maxMatching.h"
+#include "../Stream/WeightClassStream.h"
+
+Matching getWeightedApproxMaximumMatching(
+    WeightedStream* stream,
+    float epsilon,
+    Config config
+) {
+    config.budget = nullptr;
+    config.checkpoint = nullptr;
+
+    // First pass, finding the maximum weight and the number of vertices.
+    double max_weight = 0;
+    unordered_set<Vertex> vertices;
+    WeightedEdge weighted_edge = stream->readWeightedStream();
+    while (weighted_edge.edge.first != -1) {
+        max_weight = max(max_weight, weighted_edge.weight);
+        vertices.insert(weighted_edge.edge.first);
+        vertices.insert(weighted_edge.edge.second);
+        weighted_edge = stream->readWeightedStream();
+    }
+
+    Matching result;
+    if (max_weight <= 0) return result;
+
+    double min_weight = epsilon * max_weight / vertices.size();
+    double base = 1 + epsilon;
+    vertices.clear();
+
+    // Second pass, finding which weight classes hold edges. Class k holds weights in (max / base^(k+1), max / base^k].
+    set<int> classes;
+    weighted_edge = stream->readWeightedStream();
+    while (weighted_edge.edge.first != -1) {
+        if (weighted_edge.weight >= min_weight) {
+            classes.insert(static_cast<int>(floor(log(max_weight / weighted_edge.weight) / log(base))));
+        }
+        weighted_edge = stream->readWeightedStream();
+    }
+
+    Matching class_matching;
+    bool first_class = true;
+    for (int weight_class : classes) {
+        double class_weight = max(min_weight, max_weight / pow(base, weight_class + 1));
+        WeightClassStream class_stream(stream, class_weight);
+
+        // Every edge of the class above is also in this class, so its matching is a valid starting point.
+        if (first_class) class_matching = getMMSSApproxMaximumMatching(&class_stream, epsilon, config);
+        else class_matching = warmStartMMSSApproxMaximumMatching(&class_stream, epsilon, &class_matching, 0, config);
+        first_class = false;
+
+        // Merging the class matching into the result, heavier classes have already claimed their vertices.
+        for (Edge edge : class_matching.matched_edges) {
+            if (! result.isVertexUsedInMatching(edge.first) && ! result.isVertexUsedInMatching(edge.second)) {
+                result.addEdge(edge);
+            }
+        }
+
+        if (config.progress_report >= SCALE) {
+            std::cout << "Weight class " << weight_class << " (weight >= " << class_weight << "): matching size ";
+            std::cout << class_matching.matched_edges.size() << ", result size " << result.matched_edges.size();
+            std::cout << ", passes " << stream->number_of_passes << '\n';
+        }
+    }
+
+    return result;
+}
+
+double getMatchingWeight(
+    WeightedStream* stream,
+    Matching* matching
+) {
+    unordered_map<Edge, double, boost::hash<Edge>> matched_edge_weights;
+
+    WeightedEdge weighted_edge = stream->readWeightedStream();
+    while (weighted_edge.edge.first != -1) {
+        if (matching->isInMatching(weighted_edge.edge)) {
+            Edge std_edge = make_pair(
+                min(weighted_edge.edge.first, weighted_edge.edge.second),
+                max(weighted_edge.edge.first, weighted_edge.edge.second)
+            );
+            double& weight = matched_edge_weights[std_edge];
+            weight = max(weight, weighted_edge.weight);
+        }
+        weighted_edge = stream->readWeightedStream();
+    }
+
+    double total_weight = 0;
+    for (pair<const Edge, double> matched_edge : matched_edge_weights) {
+        total_weight += matched_edge.second;
+    }
+    return total_weight;
+}
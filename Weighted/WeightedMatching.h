@@ -0,0 +1,30 @@
+#ifndef WEIGHTEDMATCHING_H
+#define WEIGHTEDMATCHING_H
+
+#include "../types.h"
+#include "../Stream/WeightedStream.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+// Approximate maximum weight matching using weight classes. Edges are bucketed by powers of (1 + epsilon) below the
+// maximum weight, edges lighter than epsilon * max_weight / n are ignored as together they are worth at most epsilon
+// of the optimum. From the heaviest class down, the unweighted engine finds a matching of every edge at least as heavy
+// as the class, warm started from the matching of the class above, and its edges are merged into the result whenever
+// both endpoints are still free. Only non-empty classes are run.
+//
+// Memory stays O(n) as only the current class matching and the result are held. Passes used are counted on the
+// weighted stream. The budget and checkpoint of the config belong to a single unweighted run so are not used.
+Matching getWeightedApproxMaximumMatching(
+    WeightedStream* stream,
+    float epsilon,
+    Config config
+);
+
+// Total weight of the matching in a single pass, using the heaviest copy of any repeated edge.
+double getMatchingWeight(
+    WeightedStream* stream,
+    Matching* matching
+);
+
+#endif //WEIGHTEDMATCHING_H
@@ -0,0 +1,169 @@
+#include "SlidingWindowMatching.h"
+
+#include <algorithm>
+
+static Edge getStandardEdge(Edge edge) {
+    return make_pair(min(edge.first, edge.second), max(edge.first, edge.second));
+}
+
+SlidingWindowMatching::SlidingWindowMatching(double window_length, size_t neighbours_per_vertex) {
+    this->window_length = window_length;
+    this->neighbours_per_vertex = neighbours_per_vertex;
+}
+
+bool SlidingWindowMatching::isExpired(double timestamp) const {
+    return timestamp < current_time - window_length;
+}
+
+void SlidingWindowMatching::touchVertex(Vertex vertex, double timestamp) {
+    auto found = window_vertices.find(vertex);
+    if (found != window_vertices.end()) {
+        vertex_expiry.erase(make_pair(found->second.last_seen, vertex));
+    } else {
+        found = window_vertices.emplace(vertex, WindowVertex()).first;
+    }
+    found->second.last_seen = timestamp;
+    vertex_expiry.insert(make_pair(timestamp, vertex));
+}
+
+void SlidingWindowMatching::addNeighbour(Vertex vertex, Vertex neighbour, double timestamp) {
+    vector<pair<Vertex, double>>& neighbours = window_vertices[vertex].neighbours;
+
+    // Refreshing the neighbour if already known, otherwise replacing the oldest neighbour once the list is full.
+    size_t oldest = 0;
+    for (size_t i = 0; i < neighbours.size(); i++) {
+        if (neighbours[i].first == neighbour) {
+            neighbours[i].second = timestamp;
+            return;
+        }
+        if (neighbours[i].second < neighbours[oldest].second) oldest = i;
+    }
+
+    if (neighbours.size() < neighbours_per_vertex) neighbours.emplace_back(neighbour, timestamp);
+    else neighbours[oldest] = make_pair(neighbour, timestamp);
+}
+
+void SlidingWindowMatching::matchEdge(Edge edge, double timestamp) {
+    Edge std_edge = getStandardEdge(edge);
+    matching.addEdge(std_edge);
+    matched_edge_last_seen[std_edge] = timestamp;
+    matched_edge_expiry.insert(make_pair(timestamp, std_edge));
+}
+
+void SlidingWindowMatching::unmatchEdge(Edge edge) {
+    Edge std_edge = getStandardEdge(edge);
+    auto found = matched_edge_last_seen.find(std_edge);
+    matched_edge_expiry.erase(make_pair(found->second, std_edge));
+    matched_edge_last_seen.erase(found);
+    matching.removeEdgeAndItsVertices(std_edge);
+}
+
+Vertex SlidingWindowMatching::findFreeNeighbour(Vertex vertex, Vertex excluded, double* timestamp) {
+    /* Returns a free neighbour of the vertex other than excluded, or -1 if there is none. Neighbours whose edge has
+       left the window are dropped as they are found. */
+    auto found = window_vertices.find(vertex);
+    if (found == window_vertices.end()) return -1;
+
+    vector<pair<Vertex, double>>& neighbours = found->second.neighbours;
+    for (size_t i = 0; i < neighbours.size();) {
+        if (isExpired(neighbours[i].second)) {
+            neighbours[i] = neighbours.back();
+            neighbours.pop_back();
+            continue;
+        }
+        if (neighbours[i].first != excluded && ! matching.isVertexUsedInMatching(neighbours[i].first)) {
+            *timestamp = neighbours[i].second;
+            return neighbours[i].first;
+        }
+        i++;
+    }
+    return -1;
+}
+
+bool SlidingWindowMatching::augmentThroughMate(Vertex free_vertex, Vertex matched_vertex, double timestamp) {
+    /* Looks for the length 3 augmenting path free_vertex - matched_vertex = mate - other, where other is a free
+       neighbour of the mate. */
+    Edge matched_edge = matching.getMatchedEdgeFromVertex(matched_vertex);
+    Vertex mate = (matched_edge.first == matched_vertex) ? matched_edge.second : matched_edge.first;
+
+    double other_timestamp = 0;
+    Vertex other = findFreeNeighbour(mate, free_vertex, &other_timestamp);
+    if (other == -1) return false;
+
+    unmatchEdge(matched_edge);
+    matchEdge(make_pair(free_vertex, matched_vertex), timestamp);
+    matchEdge(make_pair(mate, other), other_timestamp);
+    return true;
+}
+
+void SlidingWindowMatching::advanceTime(double timestamp) {
+    current_time = max(current_time, timestamp);
+
+    // Unmatching matched edges which have left the window.
+    vector<Vertex> freed_vertices;
+    while (!matched_edge_expiry.empty() && isExpired(matched_edge_expiry.begin()->first)) {
+        Edge edge = matched_edge_expiry.begin()->second;
+        unmatchEdge(edge);
+        freed_vertices.emplace_back(edge.first);
+        freed_vertices.emplace_back(edge.second);
+    }
+
+    // Forgetting vertices with no edges left in the window.
+    while (!vertex_expiry.empty() && isExpired(vertex_expiry.begin()->first)) {
+        window_vertices.erase(vertex_expiry.begin()->second);
+        vertex_expiry.erase(vertex_expiry.begin());
+    }
+
+    // Rematching the freed vertices from their remaining neighbours.
+    for (Vertex vertex : freed_vertices) {
+        if (matching.isVertexUsedInMatching(vertex)) continue;
+
+        double neighbour_timestamp = 0;
+        Vertex neighbour = findFreeNeighbour(vertex, -1, &neighbour_timestamp);
+        if (neighbour != -1) matchEdge(make_pair(vertex, neighbour), neighbour_timestamp);
+    }
+}
+
+void SlidingWindowMatching::addEdge(Edge edge, double timestamp) {
+    if (edge.first == edge.second) return;
+
+    advanceTime(timestamp);
+    touchVertex(edge.first, timestamp);
+    touchVertex(edge.second, timestamp);
+    addNeighbour(edge.first, edge.second, timestamp);
+    addNeighbour(edge.second, edge.first, timestamp);
+
+    bool u_matched = matching.isVertexUsedInMatching(edge.first);
+    bool v_matched = matching.isVertexUsedInMatching(edge.second);
+
+    if (matching.isInMatching(edge)) {
+        // Refreshing the time the matched edge was last seen, so it stays in the window.
+        unmatchEdge(edge);
+        matchEdge(edge, timestamp);
+    } else if (!u_matched && !v_matched) {
+        matchEdge(edge, timestamp);
+    } else if (!u_matched) {
+        augmentThroughMate(edge.first, edge.second, timestamp);
+    } else if (!v_matched) {
+        augmentThroughMate(edge.second, edge.first, timestamp);
+    }
+}
+
+long SlidingWindowMatching::processStream(TimestampedStream* stream) {
+    /* Adds every edge of a single pass of the stream to the window, returning the number of edges read. */
+    long edges_read = 0;
+
+    TimestampedEdge timestamped_edge = stream->readTimestampedStream();
+    // edges are only -1 if we have reached the end of the stream.
+    while (timestamped_edge.edge.first != -1) {
+        addEdge(timestamped_edge.edge, timestamped_edge.timestamp);
+        edges_read += 1;
+        timestamped_edge = stream->readTimestampedStream();
+    }
+
+    return edges_read;
+}
+
+size_t SlidingWindowMatching::getWindowVertexCount() const {
+    return window_vertices.size();
+}
@@ -0,0 +1,55 @@
+#ifndef SLIDINGWINDOWMATCHING_H
+#define SLIDINGWINDOWMATCHING_H
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "../types.h"
+#include "../Stream/TimestampedStream.h"
+#include "../Structures/Matching.h"
+
+using namespace std;
+
+// Maintains an approximate maximum matching over the edges seen in the last window_length time units of a timestamped
+// stream. Matched edges which leave the window are unmatched and their endpoints rematched from their recent
+// neighbours. Each vertex keeps at most neighbours_per_vertex recent neighbours, and vertices are forgotten once all of
+// their edges have left the window, so memory is bounded by the number of vertices in the window.
+class SlidingWindowMatching {
+    // Variables
+    public:
+        Matching matching;
+        double window_length;
+        size_t neighbours_per_vertex;
+    private:
+        struct WindowVertex {
+            double last_seen = 0;
+            // Recent neighbours along with the time the edge to them was last seen.
+            vector<pair<Vertex, double>> neighbours;
+        };
+
+        unordered_map<Vertex, WindowVertex> window_vertices;
+        unordered_map<Edge, double, boost::hash<Edge>> matched_edge_last_seen;
+        // Ordered by the time last seen, so the next vertex or matched edge to expire is first.
+        set<pair<double, Vertex>> vertex_expiry;
+        set<pair<double, Edge>> matched_edge_expiry;
+        double current_time = 0;
+
+    // Functions
+    public:
+        explicit SlidingWindowMatching(double window_length, size_t neighbours_per_vertex = 16);
+        void addEdge(Edge edge, double timestamp);
+        void advanceTime(double timestamp);
+        long processStream(TimestampedStream* stream);
+        size_t getWindowVertexCount() const;
+    private:
+        bool isExpired(double timestamp) const;
+        void touchVertex(Vertex vertex, double timestamp);
+        void addNeighbour(Vertex vertex, Vertex neighbour, double timestamp);
+        void matchEdge(Edge edge, double timestamp);
+        void unmatchEdge(Edge edge);
+        Vertex findFreeNeighbour(Vertex vertex, Vertex excluded, double* timestamp);
+        bool augmentThroughMate(Vertex free_vertex, Vertex matched_vertex, double timestamp);
+};
+
+#endif //SLIDINGWINDOWMATCHING_H
@@ -0,0 +1,395 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "MaximumMatchings.h"
+
+using namespace std;
+
+// Number of vertices whose state fits in the simulated cache used to report the locality of an edge order.
+static const int LOCALITY_CACHE_VERTICES = 4096;
+
+// Set on SIGINT or SIGTERM, so an interrupted run still returns the matching found so far.
+atomic<bool> stop_requested(false);
+
+void requestStop(int /*signal_number*/) {
+    stop_requested = true;
+}
+
+static void printUsage() {
+    std::cerr << "Usage: MaximumMatchings --input FILE [options]\n"
+        << "  --input FILE               edge list, a line \"u v\" per edge (\"u v w\" for weighted), - for stdin\n"
+        << "  --spool FILE               new file stdin is spooled to for later passes (default a unique file in $TMPDIR or /tmp)\n"
+        << "  --format NAME              edges or weighted (default edges)\n"
+        << "  --stream NAME              memory to load the edges, or file to stream them from disk (default memory)\n"
+        << "  --edge-order NAME          reorder an in-memory stream for locality: file, source, rcm or hilbert (default file)\n"
+        << "  --epsilon VALUE            epsilon of the approximation (default 0.25)\n"
+        << "  --optimisation LEVEL       0 to 3, see OptimisationLevel (default 3)\n"
+        << "  --threads N                run a portfolio of N differently ordered runs, or batch and component threads (default 1)\n"
+        << "  --batch                    the input holds many graphs, each starting with a line \"# graph NAME\"\n"
+        << "  --components               remove self loops and duplicate edges, then match each connected component\n"
+        << "                             separately across the threads, holding the whole graph in memory\n"
+        << "  --kernelise ROUNDS         match degree one and fold degree two vertices in up to ROUNDS rounds before the run\n"
+        << "  --max-folds N              keep at most N degree two folds in memory (default no limit)\n"
+        << "  --exact-limit N            in batch or component mode, graphs of at most N edges are solved exactly (default 4096)\n"
+        << "  --output FILE              write the matched edges to FILE\n"
+        << "  --progress LEVEL           0 to 4, see ProgressReport (default 1)\n"
+        << "  --initialiser NAME         greedy, degree or karp-sipser (default greedy)\n"
+        << "  --length-three-rounds N    rounds of length 3 augmentations after the initial matching (default 0)\n"
+        << "  --bipartite MODE           detect, or yes if the graph is known to be bipartite\n"
+        << "  --exact-finish EDGES       finish exactly in memory once at most EDGES edges are near the free vertices\n"
+        << "  --max-passes N             stop once another pass bundle would exceed N passes\n"
+        << "  --max-seconds S            stop after S seconds\n"
+        << "  --target-ratio R           stop once the matching is provably at least R of the maximum\n"
+        << "  --max-memory MB            hold back the engine once its estimated memory is over MB megabytes\n"
+        << "  --checkpoint FILE          periodically save the run to FILE\n"
+        << "  --checkpoint-interval S    seconds between checkpoints (default 300)\n"
+        << "  --resume FILE              resume the run saved in a checkpoint\n"
+        << "  --warm-start FILE          start from a matching saved in FILE\n"
+        << "  --first-scale N            scale index to start a warm start from (default 0)\n"
+        << "  --save-matching FILE       save the matching for a later warm start\n"
+        << "  --metrics FILE             write per pass bundle metrics to FILE as JSON\n"
+        << "  --trace FILE               write a binary trace of every operation to FILE\n";
+}
+
+int main(int argc, char* argv[]) {
+    string input_file;
+    string format = "edges";
+    string stream_type = "memory";
+    // Left empty for a uniquely named spool file.
+    string spool_file;
+    EdgeOrder edge_order = FILE_ORDER;
+    float epsilon = 0.25f;
+    int threads = 1;
+    bool batch_mode = false;
+    bool component_mode = false;
+    int kernel_rounds = 0;
+    long max_folds = -1;
+    long exact_edge_limit = 4096;
+    string output_file;
+    string checkpoint_file;
+    double checkpoint_interval = 300;
+    string resume_file;
+    string warm_start_file;
+    int first_scale = 0;
+    string save_matching_file;
+    string metrics_file;
+    string trace_file;
+
+    RunBudget budget;
+    budget.stop_requested = &stop_requested;
+    MemoryBudget memory_budget;
+
+    Config config;
+    config.progress_report = SCALE;
+    config.optimisation_level = PHASE_SKIP;
+    config.budget = &budget;
+    config.memory_budget = &memory_budget;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--input" && has_value) input_file = argv[++i];
+        else if (arg == "--format" && has_value) format = argv[++i];
+        else if (arg == "--stream" && has_value) stream_type = argv[++i];
+        else if (arg == "--spool" && has_value) spool_file = argv[++i];
+        else if (arg == "--edge-order" && has_value) {
+            string order = argv[++i];
+            if (order == "file") edge_order = FILE_ORDER;
+            else if (order == "source") edge_order = SOURCE_ORDER;
+            else if (order == "rcm") edge_order = RCM_ORDER;
+            else if (order == "hilbert") edge_order = HILBERT_ORDER;
+            else {
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--epsilon" && has_value) epsilon = stof(argv[++i]);
+        else if (arg == "--optimisation" && has_value) config.optimisation_level = static_cast<OptimisationLevel>(stoi(argv[++i]));
+        else if (arg == "--threads" && has_value) threads = stoi(argv[++i]);
+        else if (arg == "--batch") batch_mode = true;
+        else if (arg == "--components") component_mode = true;
+        else if (arg == "--kernelise" && has_value) kernel_rounds = stoi(argv[++i]);
+        else if (arg == "--max-folds" && has_value) max_folds = stol(argv[++i]);
+        else if (arg == "--exact-limit" && has_value) exact_edge_limit = stol(argv[++i]);
+        else if (arg == "--output" && has_value) output_file = argv[++i];
+        else if (arg == "--progress" && has_value) config.progress_report = static_cast<ProgressReport>(stoi(argv[++i]));
+        else if (arg == "--initialiser" && has_value) {
+            string initialiser = argv[++i];
+            if (initialiser == "greedy") config.initial_matching = GREEDY;
+            else if (initialiser == "degree") config.initial_matching = DEGREE_AWARE_GREEDY;
+            else if (initialiser == "karp-sipser") config.initial_matching = KARP_SIPSER;
+            else {
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--length-three-rounds" && has_value) config.length_three_augmentation_rounds = stoi(argv[++i]);
+        else if (arg == "--exact-finish" && has_value) config.exact_finish_edge_limit = stol(argv[++i]);
+        else if (arg == "--bipartite" && has_value) config.graph_type = (string(argv[++i]) == "yes") ? BIPARTITE_GRAPH : DETECT_BIPARTITE;
+        else if (arg == "--max-passes" && has_value) budget.max_passes = stoi(argv[++i]);
+        else if (arg == "--max-seconds" && has_value) budget.max_seconds = stod(argv[++i]);
+        else if (arg == "--target-ratio" && has_value) budget.target_ratio = stof(argv[++i]);
+        else if (arg == "--max-memory" && has_value) memory_budget.max_bytes = static_cast<long>(stod(argv[++i]) * 1024 * 1024);
+        else if (arg == "--checkpoint" && has_value) checkpoint_file = argv[++i];
+        else if (arg == "--checkpoint-interval" && has_value) checkpoint_interval = stod(argv[++i]);
+        else if (arg == "--resume" && has_value) resume_file = argv[++i];
+        else if (arg == "--warm-start" && has_value) warm_start_file = argv[++i];
+        else if (arg == "--first-scale" && has_value) first_scale = stoi(argv[++i]);
+        else if (arg == "--save-matching" && has_value) save_matching_file = argv[++i];
+        else if (arg == "--metrics" && has_value) metrics_file = argv[++i];
+        else if (arg == "--trace" && has_value) trace_file = argv[++i];
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (input_file.empty()) {
+        printUsage();
+        return 1;
+    }
+    // Input from stdin can only be read once, so is spooled to disk rather than loaded into memory.
+    bool from_stdin = input_file == "-";
+
+    /* Each run mode only supports some of the options. Rather than silently ignoring the others, any combination of
+       a mode with an option it doesn't use is rejected. */
+    map<string, bool> given = {
+        {"--input -", from_stdin},
+        {"--spool", !spool_file.empty()},
+        {"--format weighted", format == "weighted"},
+        {"--stream file", stream_type == "file"},
+        {"--edge-order", edge_order != FILE_ORDER},
+        {"--threads", threads > 1},
+        {"--components", component_mode},
+        {"--kernelise", kernel_rounds > 0},
+        {"--max-folds", max_folds != -1},
+        {"--resume", !resume_file.empty()},
+        {"--warm-start", !warm_start_file.empty()},
+        {"--first-scale", first_scale != 0},
+        {"--save-matching", !save_matching_file.empty()},
+        {"--checkpoint", !checkpoint_file.empty()},
+        {"--metrics", !metrics_file.empty()},
+        {"--trace", !trace_file.empty()},
+        {"--max-memory", memory_budget.max_bytes >= 0},
+        {"--max-passes", budget.max_passes >= 0},
+        {"--max-seconds", budget.max_seconds >= 0},
+        {"--target-ratio", budget.target_ratio >= 0},
+    };
+    // Each active mode, along with the options it can't be used with.
+    vector<pair<string, vector<string>>> conflicts;
+    // Budgets, checkpoints and logging aren't shared between the threads of a portfolio or the graphs of a batch.
+    vector<string> per_run_options = {
+        "--checkpoint", "--metrics", "--trace", "--max-memory", "--max-passes", "--max-seconds", "--target-ratio"
+    };
+    vector<string> start_options = {"--resume", "--warm-start", "--kernelise", "--edge-order"};
+
+    if (batch_mode) {
+        vector<string> options = {"--input -", "--format weighted", "--stream file", "--components", "--save-matching"};
+        options.insert(options.end(), start_options.begin(), start_options.end());
+        options.insert(options.end(), per_run_options.begin(), per_run_options.end());
+        conflicts.emplace_back("--batch", options);
+    } else if (format == "weighted") {
+        // Weighted runs load the graph into memory, and run each weight class with its own budget.
+        vector<string> options = {"--input -", "--stream file", "--threads", "--components", "--checkpoint"};
+        options.insert(options.end(), start_options.begin(), start_options.end());
+        options.insert(options.end(), {"--max-passes", "--max-seconds", "--target-ratio"});
+        conflicts.emplace_back("--format weighted", options);
+    } else if (component_mode) {
+        // The components are split in memory, so the graph can't be streamed from disk.
+        vector<string> options = {"--stream file"};
+        options.insert(options.end(), start_options.begin(), start_options.end());
+        options.insert(options.end(), per_run_options.begin(), per_run_options.end());
+        conflicts.emplace_back("--components", options);
+    } else if (threads > 1) {
+        vector<string> options = {"--stream file"};
+        options.insert(options.end(), start_options.begin(), start_options.end());
+        options.insert(options.end(), per_run_options.begin(), per_run_options.end());
+        conflicts.emplace_back("--threads", options);
+    } else {
+        // A single run starts from at most one of a checkpoint, a saved matching or a kernel.
+        if (given["--resume"]) conflicts.emplace_back("--resume", vector<string>{"--warm-start", "--kernelise"});
+        if (given["--warm-start"]) conflicts.emplace_back("--warm-start", vector<string>{"--kernelise"});
+        // Only edges loaded into memory can be reordered.
+        if (given["--edge-order"]) conflicts.emplace_back("--edge-order", vector<string>{"--input -", "--stream file"});
+    }
+    // Options only used along with another option.
+    vector<pair<string, string>> requirements = {
+        {"--first-scale", "--warm-start"}, {"--max-folds", "--kernelise"}, {"--spool", "--input -"}
+    };
+
+    for (pair<string, vector<string>>& conflict : conflicts) {
+        for (string& option : conflict.second) {
+            if (given[option]) {
+                std::cerr << option << " can't be used with " << conflict.first << '\n';
+                printUsage();
+                return 1;
+            }
+        }
+    }
+    for (pair<string, string>& requirement : requirements) {
+        if (given[requirement.first] && !given[requirement.second]) {
+            std::cerr << requirement.first << " needs " << requirement.second << '\n';
+            printUsage();
+            return 1;
+        }
+    }
+
+    signal(SIGINT, requestStop);
+    signal(SIGTERM, requestStop);
+
+    if (batch_mode) {
+        GraphBatch batch = readGraphBatch(input_file);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        vector<BatchGraphResult> results = getBatchMatchings(batch, epsilon, config, threads, exact_edge_limit);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        long exact_graphs = 0;
+        for (const BatchGraphResult& result : results) {
+            if (result.exact) exact_graphs += 1;
+        }
+        if (!output_file.empty()) {
+            // A line "NAME MATCHING_SIZE PASSES EXACT" per graph.
+            ofstream output(output_file);
+            for (size_t i = 0; i < results.size(); i++) {
+                output << batch.names[i] << " " << results[i].matching_size << " " << results[i].passes << " " << results[i].exact << '\n';
+            }
+        }
+
+        std::cout << "Graphs: " << results.size() << " (" << exact_graphs << " solved exactly)" << '\n';
+        std::cout << "Wall time (ms): " << seconds * 1000 << '\n';
+        std::cout << "Graphs per second: " << results.size() / seconds << '\n';
+        return 0;
+    }
+
+    Metrics metrics;
+    if (!metrics_file.empty()) config.metrics = &metrics;
+    TraceLog* trace_log = trace_file.empty() ? nullptr : new TraceLog(trace_file);
+    config.trace_log = trace_log;
+    Checkpoint* checkpoint = checkpoint_file.empty() ? nullptr : new Checkpoint(checkpoint_file, checkpoint_interval);
+    config.checkpoint = checkpoint;
+
+    MatchingResult result;
+    // Reading stdin fails if its edges can't be spooled for the later passes.
+    try {
+        if (format == "weighted") {
+            WeightedStreamFromMemory stream(input_file);
+            result = runMaximumWeightMatching(&stream, epsilon, config);
+        } else if (component_mode) {
+            Stream* stream;
+            if (from_stdin) stream = new StreamFromPipe(STDIN_FILENO, spool_file);
+            else stream = new StreamFromMemory(input_file);
+            PreprocessingStatistics statistics;
+            result = runComponentMaximumMatching(stream, epsilon, config, threads, exact_edge_limit, &statistics);
+            delete stream;
+
+            std::cout << "Preprocessing: " << statistics.edges_read << " edges read, " << statistics.self_loops << " self loops and ";
+            std::cout << statistics.duplicate_edges << " duplicate edges removed" << '\n';
+            std::cout << "Components: " << statistics.components << " over " << statistics.vertices << " vertices, the largest with ";
+            std::cout << statistics.largest_component_edges << " edges" << '\n';
+        } else if (threads > 1) {
+            // A portfolio needs the edges in memory, each edge is kept once.
+            Stream* stream;
+            if (from_stdin) stream = new StreamFromPipe(STDIN_FILENO, spool_file);
+            else stream = new StreamFromMemory(input_file);
+            vector<Edge> edges;
+            for (Edge edge = stream->readStream(); edge.first != -1; edge = stream->readStream()) {
+                if (edge.first < edge.second) edges.emplace_back(edge);
+            }
+            delete stream;
+            result = runMaximumMatching(edges, epsilon, config, threads);
+        } else {
+            Stream* stream;
+            if (from_stdin) {
+                stream = new StreamFromPipe(STDIN_FILENO, spool_file);
+            } else if (stream_type == "file") {
+                stream = new StreamFromFile(input_file);
+            } else {
+                StreamFromMemory* memory_stream = new StreamFromMemory(input_file);
+                if (edge_order != FILE_ORDER) {
+                    // Comparing the locality of the orders with a cache holding the state of a few thousand vertices.
+                    double miss_rate_before = memory_stream->getVertexCacheMissRate(LOCALITY_CACHE_VERTICES);
+                    memory_stream->reorder(edge_order);
+                    double miss_rate_after = memory_stream->getVertexCacheMissRate(LOCALITY_CACHE_VERTICES);
+                    std::cout << "Vertex cache miss rate: " << miss_rate_before << " in file order, " << miss_rate_after;
+                    std::cout << " after reordering" << '\n';
+                }
+                stream = memory_stream;
+            }
+
+            if (!resume_file.empty()) {
+                CheckpointState state;
+                if (!Checkpoint::read(resume_file, &state)) return 1;
+                result.matching = resumeMMSSApproxMaximumMatching(stream, &state, config);
+                result.passes = stream->number_of_passes;
+            } else if (!warm_start_file.empty()) {
+                Matching saved_matching;
+                if (!loadMatching(warm_start_file, &saved_matching)) return 1;
+                result.matching = warmStartMMSSApproxMaximumMatching(stream, epsilon, &saved_matching, first_scale, config);
+                result.passes = stream->number_of_passes;
+            } else if (kernel_rounds > 0) {
+                KernelisationStatistics statistics;
+                result = runKernelisedMaximumMatching(stream, epsilon, config, kernel_rounds, max_folds, &statistics);
+                std::cout << "Kernelisation: " << statistics.rounds << " rounds in " << statistics.passes << " passes, ";
+                std::cout << statistics.degree_one_matches << " degree one matches, " << statistics.triangle_matches;
+                std::cout << " triangle matches, " << statistics.folds << " folds" << '\n';
+                std::cout << "Kernel: " << statistics.residual_vertices << " of " << statistics.vertices << " vertices left" << '\n';
+            } else {
+                result = runMaximumMatching(stream, epsilon, config);
+            }
+            result.matching_size = result.matching.matched_edges.size();
+            result.termination_reason = budget.termination_reason;
+
+            delete stream;
+        }
+    } catch (const runtime_error& error) {
+        std::cerr << error.what() << '\n';
+        return 1;
+    }
+
+    if (trace_log != nullptr) {
+        trace_log->close();
+        delete trace_log;
+    }
+    delete checkpoint;
+
+    if (!metrics_file.empty()) {
+        ofstream metrics_output(metrics_file);
+        metrics.writeJSON(metrics_output);
+    }
+    if (!save_matching_file.empty() && !saveMatching(save_matching_file, &result.matching)) return 1;
+    if (!output_file.empty()) {
+        ofstream output(output_file);
+        for (Edge edge : result.matching.matched_edges) {
+            output << edge.first << " " << edge.second << '\n';
+        }
+    }
+
+    std::cout << "Matching size: " << result.matching_size << '\n';
+    if (format == "weighted") std::cout << "Matching weight: " << result.matching_weight << '\n';
+    std::cout << "Total number of passes: " << result.passes << '\n';
+    if (result.wall_time_ms > 0) std::cout << "Wall time (ms): " << result.wall_time_ms << '\n';
+    std::cout << "Termination reason: " << result.termination_reason << '\n';
+    // Batch, component and portfolio runs don't share the memory budget, and a run certified before its first phase
+    // never measures it, so a peak of 0 would be misleading.
+    if (memory_budget.measurements == 0) {
+        std::cout << "Peak memory (bytes): not measured" << '\n';
+    } else {
+        std::cout << "Peak memory (bytes): " << memory_budget.peak.getTotal() << " (structures " << memory_budget.peak.structures;
+        std::cout << ", blossoms " << memory_budget.peak.blossoms << ", edge buffer " << memory_budget.peak.edge_buffer;
+        std::cout << ", matching " << memory_budget.peak.matching << ")" << '\n';
+    }
+    if (memory_budget.max_bytes >= 0) {
+        std::cout << "Memory limit: " << memory_budget.held_pass_bundles << " pass bundles held, " << memory_budget.phases_ended_early;
+        std::cout << " phases ended early, " << memory_budget.edge_buffer_flushes << " edge buffer flushes" << '\n';
+    }
+
+    return 0;
+}
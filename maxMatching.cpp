@@ -1,9 +1,19 @@
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <set>
 
+#include "maxMatching.h"
 #include "types.h"
 
+#include "Anytime/RunBudget.h"
+#include "Anytime/UpperBound.h"
+#include "Bipartite/BipartiteDetection.h"
+#include "Checkpoint/Checkpoint.h"
+#include "Exact/ExactMatchingSolver.h"
+#include "Exact/ResidualGraph.h"
+#include "Initialisers/InitialMatching.h"
+#include "Memory/MemoryBudget.h"
 #include "Stream/Stream.h"
 #include "Stream/StreamFromFile.h"
 #include "Stream/StreamFromMemory.h"
@@ -12,10 +22,19 @@
 #include "Structures/FreeNodeStructure.h"
 #include "Structures/GraphStructure/GraphBlossom.h"
 #include "Structures/GraphStructure/GraphVertex.h"
+#include "Metrics/Metrics.h"
+#include "Portfolio/Portfolio.h"
 #include "Structures/Matching.h"
+#include "Tracing/TraceLog.h"
 
 using namespace std;
 
+// Each pass bundle makes one pass to extend active paths, and two to contract and augment. The contraction pass is
+// skipped for bipartite graphs.
+int getPassesPerPassBundle(Config config) {
+    return (config.graph_type == BIPARTITE_GRAPH) ? 2 : 3;
+}
+
 vector<Edge> getLeafToRootPath(
     GraphNode* leaf
 ) {
@@ -211,49 +230,15 @@ void augment(
     disjoint_augmenting_paths->emplace_back(new_augmentation);
 }
 
-void contractAndAugment(
-    Stream* stream,
-    AvailableFreeNodes* available_free_nodes,
-    vector<AugmentingPath>* disjoint_augmenting_paths,
+void contractBufferedEdges(
+    unordered_map<FreeNodeStructure*, vector<Edge>>* edges_in_structures,
     Matching* matching,
     Config config,
     int* operations_completed
 ) {
+    PassBundleMetrics* metrics = (config.metrics != nullptr) ? config.metrics->currentPassBundle() : nullptr;
 
-    unordered_map<FreeNodeStructure*, vector<Edge>> edges_in_structures;
-
-    // Contraction Step
-    Edge edge = stream->readStream();
-    // edges are only -1 if we have reached the end of the stream.
-    while (edge.first != -1) {
-
-        FreeNodeStructure* struct_of_u = available_free_nodes->getFreeNodeStructFromVertex(edge.first);
-        FreeNodeStructure* struct_of_v = available_free_nodes->getFreeNodeStructFromVertex(edge.second);
-
-        // If the two vertices are in the same non-removed structure.
-        if (
-            struct_of_u != nullptr && struct_of_u == struct_of_v &&
-            ! struct_of_u->removed && ! struct_of_v->removed
-        ) {
-            GraphNode* node_of_u = struct_of_u->getGraphNodeFromVertex(edge.first);
-            GraphNode* node_of_v = struct_of_u->getGraphNodeFromVertex(edge.second);
-
-            // If the two vertices are not in the same root blossom.
-            if (node_of_u != node_of_v) {
-                // Adding the edge to the list of edges connecting vertices in the structure
-                if (edges_in_structures.find(struct_of_u) == edges_in_structures.end()) {
-                    edges_in_structures[struct_of_u] = {edge};
-                } else {
-                    edges_in_structures[struct_of_u].emplace_back(edge);
-                }
-            }
-        }
-
-        // Reading next edge
-        edge = stream->readStream();
-    }
-
-    for (pair<FreeNodeStructure*, vector<Edge>> pair : edges_in_structures) {
+    for (pair<FreeNodeStructure*, vector<Edge>> pair : *edges_in_structures) {
         int contractions_in_last_iteration = -1;
         while (contractions_in_last_iteration != 0) {
             contractions_in_last_iteration = 0;
@@ -274,17 +259,93 @@ void contractAndAugment(
                     contractions_in_last_iteration += 1;
 
                     *operations_completed += 1;
+                    if (metrics != nullptr) metrics->contractions += 1;
+                    if (config.trace_log != nullptr) {
+                        config.trace_log->record(TRACE_CONTRACT, pair.first->free_node_root->vertex_id, -1, edge_in_struct);
+                    }
                     if (config.progress_report >= VERBOSE) {
                         std::cout << "ContractAndAugment - Contract: Struct " << pair.first->free_node_root->vertex_id;
-                        std::cout << " on edge " << edge_in_struct.first << "->" << edge_in_struct.second << std::endl;
+                        std::cout << " on edge " << edge_in_struct.first << "->" << edge_in_struct.second << '\n';
                     }
                 }
             }
         }
     }
+}
+
+long contractAndAugment(
+    Stream* stream,
+    AvailableFreeNodes* available_free_nodes,
+    vector<AugmentingPath>* disjoint_augmenting_paths,
+    Matching* matching,
+    Config config,
+    int* operations_completed,
+    long edge_buffer_limit
+) {
+    /* Contracts blossoms and augments between structures in two passes, returning the peak bytes held by the edges
+       buffered for contraction. */
+
+    PassBundleMetrics* metrics = (config.metrics != nullptr) ? config.metrics->currentPassBundle() : nullptr;
+
+    unordered_map<FreeNodeStructure*, vector<Edge>> edges_in_structures;
+    long edges_buffered = 0;
+    long peak_edges_buffered = 0;
+
+    // Both passes only act on edges between vertices in structures which haven't been removed. Structures don't gain
+    // vertices during either pass, so streams able to drop edges at their source only need to send those edges.
+    bool restrict_passes = stream->canRestrictPasses();
+
+    // Contraction Step - skipped for bipartite graphs, as no edge joins two outer vertices of a structure so blossoms
+    // never form, saving a pass.
+    if (config.graph_type != BIPARTITE_GRAPH) {
+        if (restrict_passes) stream->restrictNextPass(available_free_nodes->getVerticesInLiveStructures());
+        Edge edge = stream->readStream();
+        // edges are only -1 if we have reached the end of the stream.
+        while (edge.first != -1) {
+
+            FreeNodeStructure* struct_of_u = available_free_nodes->getFreeNodeStructFromVertex(edge.first);
+            FreeNodeStructure* struct_of_v = available_free_nodes->getFreeNodeStructFromVertex(edge.second);
+
+            // If the two vertices are in the same non-removed structure.
+            if (
+                struct_of_u != nullptr && struct_of_u == struct_of_v &&
+                ! struct_of_u->removed && ! struct_of_v->removed
+            ) {
+                GraphNode* node_of_u = struct_of_u->getGraphNodeFromVertex(edge.first);
+                GraphNode* node_of_v = struct_of_u->getGraphNodeFromVertex(edge.second);
+
+                // If the two vertices are not in the same root blossom.
+                if (node_of_u != node_of_v) {
+                    // Memory budget - contracting the edges buffered so far rather than going over the limit. Edges
+                    // which would have led to a contraction after a later one are found in the next pass bundle.
+                    if (edge_buffer_limit >= 0 && edges_buffered > 0 && edges_buffered >= edge_buffer_limit) {
+                        contractBufferedEdges(&edges_in_structures, matching, config, operations_completed);
+                        edges_in_structures.clear();
+                        edges_buffered = 0;
+                        config.memory_budget->edge_buffer_flushes += 1;
+                    }
+
+                    // Adding the edge to the list of edges connecting vertices in the structure
+                    if (edges_in_structures.find(struct_of_u) == edges_in_structures.end()) {
+                        edges_in_structures[struct_of_u] = {edge};
+                    } else {
+                        edges_in_structures[struct_of_u].emplace_back(edge);
+                    }
+                    edges_buffered += 1;
+                    peak_edges_buffered = max(peak_edges_buffered, edges_buffered);
+                }
+            }
+
+            // Reading next edge
+            edge = stream->readStream();
+        }
+
+        contractBufferedEdges(&edges_in_structures, matching, config, operations_completed);
+    }
 
     // Augmentation Step
-    edge = stream->readStream();
+    if (restrict_passes) stream->restrictNextPass(available_free_nodes->getVerticesInLiveStructures());
+    Edge edge = stream->readStream();
     // edges are only -1 if we have reached the end of the stream.
     while (edge.first != -1) {
 
@@ -303,11 +364,15 @@ void contractAndAugment(
                 augment(disjoint_augmenting_paths, edge, available_free_nodes, matching);
 
                 *operations_completed += 1;
+                if (metrics != nullptr) metrics->augmentations += 1;
 
+                if (config.trace_log != nullptr) {
+                    config.trace_log->record(TRACE_AUGMENT, struct_of_u->free_node_root->vertex_id, struct_of_v->free_node_root->vertex_id, edge);
+                }
                 if (config.progress_report >= VERBOSE) {
                     std::cout << "ContractAndAugment - Augment: Struct " << struct_of_u->free_node_root->vertex_id;
                     std::cout << " and Struct "<< struct_of_v->free_node_root->vertex_id;
-                    std::cout << " on edge " << edge.first << "->" << edge.second << std::endl;
+                    std::cout << " on edge " << edge.first << "->" << edge.second << '\n';
                 }
             }
         }
@@ -315,6 +380,8 @@ void contractAndAugment(
         // Reading next edge
         edge = stream->readStream();
     }
+
+    return getEdgeBufferBytes(peak_edges_buffered);
 }
 
 void backtrackStuckStructures(
@@ -322,6 +389,8 @@ void backtrackStuckStructures(
     Config config,
     int* operations_completed
 ) {
+    PassBundleMetrics* metrics = (config.metrics != nullptr) ? config.metrics->currentPassBundle() : nullptr;
+
     for (FreeNodeStructure* structure : available_free_nodes->free_node_structures) {
         if (structure->on_hold || structure->modified || structure->removed || structure->working_node == nullptr) {
             continue;
@@ -330,9 +399,13 @@ void backtrackStuckStructures(
         structure->backtrack();
 
         *operations_completed += 1;
+        if (metrics != nullptr) metrics->backtracks += 1;
+        if (config.trace_log != nullptr) {
+            config.trace_log->record(TRACE_BACKTRACK, structure->free_node_root->vertex_id);
+        }
         if (config.progress_report >= VERBOSE) {
-            std::cout << "Backtracking: Struct " << structure->free_node_root->vertex_id << std::endl;
-            if (structure->working_node == nullptr) std::cout << "Struct " << structure->free_node_root->vertex_id << " now inactive." << std::endl;
+            std::cout << "Backtracking: Struct " << structure->free_node_root->vertex_id << '\n';
+            if (structure->working_node == nullptr) std::cout << "Struct " << structure->free_node_root->vertex_id << " now inactive." << '\n';
         }
     }
 }
@@ -345,6 +418,7 @@ void overtake(
     Config config
 ) {
     // TODO: Add input check?
+    PassBundleMetrics* metrics = (config.metrics != nullptr) ? config.metrics->currentPassBundle() : nullptr;
 
     FreeNodeStructure* struct_of_u = available_free_nodes->getFreeNodeStructFromVertex(unmatched_arc.first);
     FreeNodeStructure* struct_of_v = available_free_nodes->getFreeNodeStructFromVertex(unmatched_arc.second);
@@ -389,9 +463,13 @@ void overtake(
 
         struct_of_u->modified = true;
 
+        if (metrics != nullptr) metrics->overtakes_case_1 += 1;
+        if (config.trace_log != nullptr) {
+            config.trace_log->record(TRACE_OVERTAKE_CASE_1, struct_of_u->free_node_root->vertex_id, -1, unmatched_arc);
+        }
         if (config.progress_report >= VERBOSE) {
             std::cout << "Overtake Case 1: Struct " << struct_of_u->free_node_root->vertex_id;
-            std::cout << ", edge " << unmatched_arc.first << "->" << unmatched_arc.second << std::endl;
+            std::cout << ", edge " << unmatched_arc.first << "->" << unmatched_arc.second << '\n';
         }
     }
 
@@ -441,9 +519,13 @@ void overtake(
 
             updateChildLabels(vertex_v, current_label+1, matching);
 
+            if (metrics != nullptr) metrics->overtakes_case_2_1 += 1;
+            if (config.trace_log != nullptr) {
+                config.trace_log->record(TRACE_OVERTAKE_CASE_2_1, struct_of_u->free_node_root->vertex_id, -1, unmatched_arc);
+            }
             if (config.progress_report >= VERBOSE) {
                 std::cout << "Overtake Case 2.1: Struct " << struct_of_u->free_node_root->vertex_id;
-                std::cout << " on itself, edge " << unmatched_arc.first << "->" << unmatched_arc.second << std::endl;
+                std::cout << " on itself, edge " << unmatched_arc.first << "->" << unmatched_arc.second << '\n';
             }
         }
         // Case 2.2: If the matched arc is in a different structure to u, with the unmatched arc (u,v) joining the two structures.
@@ -474,7 +556,6 @@ void overtake(
                 //blossom_u->outsideBlossomToIn[vertex_v] = unmatched_arc.first;
             }
 
-
             vertex_v->parent = vertex_u;
             vertex_v->parent_index = unmatched_arc.first;
 
@@ -494,10 +575,14 @@ void overtake(
 
             updateChildLabels(vertex_v, current_label+1, matching);
 
+            if (metrics != nullptr) metrics->overtakes_case_2_2 += 1;
+            if (config.trace_log != nullptr) {
+                config.trace_log->record(TRACE_OVERTAKE_CASE_2_2, struct_of_u->free_node_root->vertex_id, struct_of_v->free_node_root->vertex_id, unmatched_arc);
+            }
             if (config.progress_report >= VERBOSE) {
                 std::cout << "Overtake Case 2.2: Struct " << struct_of_u->free_node_root->vertex_id;
                 std::cout << " on Struct "<< struct_of_v->free_node_root->vertex_id;
-                std::cout << ", edge " << unmatched_arc.first << "->" << unmatched_arc.second << std::endl;
+                std::cout << ", edge " << unmatched_arc.first << "->" << unmatched_arc.second << '\n';
             }
         }
     }
@@ -509,17 +594,23 @@ void extendActivePath(
     AvailableFreeNodes* available_free_nodes,
     vector<AugmentingPath>* disjoint_augmenting_paths,
     Config config,
-    int* operations_completed
+    int* operations_completed,
+    bool create_structures
 ) {
+    PassBundleMetrics* metrics = (config.metrics != nullptr) ? config.metrics->currentPassBundle() : nullptr;
+
     Edge edge = stream->readStream();
     // edges are only -1 if we have reached the end of the stream.
     while (edge.first != -1) {
+        if (metrics != nullptr) metrics->edges_examined += 1;
 
         // Checking whether you need to create a new FreeNodeStructure each vertex in the edge.
         // Requirements to create a new FreeNodeStructure:
         // - The vertex is not involved in the current matching
         // - The vertex does not belong to any current FreeNodeStructures.
+        // - New structures are allowed, i.e. the run isn't over its memory limit.
         if (
+            create_structures &&
             ! matching->isVertexUsedInMatching(edge.first) &&
             available_free_nodes->getFreeNodeStructFromVertex(edge.first) == nullptr
         ) {
@@ -527,6 +618,7 @@ void extendActivePath(
             available_free_nodes->createNewStruct(new_vertex_u);
         }
         if (
+            create_structures &&
             ! matching->isVertexUsedInMatching(edge.second) &&
             available_free_nodes->getFreeNodeStructFromVertex(edge.second) == nullptr
         ) {
@@ -542,11 +634,13 @@ void extendActivePath(
 
         // If u does not belong to a structure, we move to the next edge in the stream.
         if (struct_of_u == nullptr) {
+            if (metrics != nullptr) metrics->edges_skipped_no_structure += 1;
             edge = stream->readStream();
             continue;
         }
         // Case 1 - If we have "removed" one of the vertices from the graph, we skip this edge.
         if (struct_of_u->removed || (struct_of_v != nullptr && struct_of_v->removed) ) {
+            if (metrics != nullptr) metrics->edges_skipped_removed += 1;
             edge = stream->readStream();
             continue;
         }
@@ -561,12 +655,14 @@ void extendActivePath(
             (struct_of_u->working_node != struct_of_u->getGraphNodeFromVertex(edge.first)) ||
             matching->isInMatching(edge)
         ) {
+            if (metrics != nullptr) metrics->edges_skipped_not_extendable += 1;
             edge = stream->readStream();
             continue;
         }
 
         // Case 3: If the first vertex is in a "marked" or "on hold" structure, we skip this edge.
         if (struct_of_u->modified || struct_of_u->on_hold) {
+            if (metrics != nullptr) metrics->edges_skipped_modified_or_on_hold += 1;
             edge = stream->readStream();
             continue;
         }
@@ -585,9 +681,13 @@ void extendActivePath(
                     struct_of_u->contract(edge);
 
                     *operations_completed += 1;
+                    if (metrics != nullptr) metrics->contractions += 1;
+                    if (config.trace_log != nullptr) {
+                        config.trace_log->record(TRACE_CONTRACT, struct_of_u->free_node_root->vertex_id, -1, edge);
+                    }
                     if (config.progress_report >= VERBOSE) {
                         std::cout << "Contract: Struct " << struct_of_u->free_node_root->vertex_id;
-                        std::cout << " on edge" << edge.first << "->" << edge.second << std::endl;
+                        std::cout << " on edge" << edge.first << "->" << edge.second << '\n';
                     }
 
                 }
@@ -598,10 +698,14 @@ void extendActivePath(
                 augment(disjoint_augmenting_paths, edge, available_free_nodes, matching);
 
                 *operations_completed += 1;
+                if (metrics != nullptr) metrics->augmentations += 1;
+                if (config.trace_log != nullptr) {
+                    config.trace_log->record(TRACE_AUGMENT, struct_of_u->free_node_root->vertex_id, struct_of_v->free_node_root->vertex_id, edge);
+                }
                 if (config.progress_report >= VERBOSE) {
                     std::cout << "Augment: Struct " << struct_of_u->free_node_root->vertex_id;
                     std::cout << " and Struct "<< struct_of_v->free_node_root->vertex_id;
-                    std::cout << " on edge" << edge.first << "->" << edge.second << std::endl;
+                    std::cout << " on edge" << edge.first << "->" << edge.second << '\n';
                 }
             }
         }
@@ -625,6 +729,8 @@ void extendActivePath(
                 overtake(edge, matching_using_v, available_free_nodes, matching, config);
 
                 *operations_completed += 1;
+            } else if (metrics != nullptr) {
+                metrics->edges_without_overtake += 1;
             }
         }
 
@@ -633,6 +739,15 @@ void extendActivePath(
     }
 }
 
+void recordMemoryUsage(
+    const MemoryUsage& usage,
+    Config config,
+    MemoryUsage* phase_peak_memory
+) {
+    phase_peak_memory->takeMaximum(usage);
+    if (config.memory_budget != nullptr) config.memory_budget->record(usage);
+    if (config.metrics != nullptr) config.metrics->recordMemory(usage);
+}
 
 vector<AugmentingPath> algPhase(
     Stream* stream,
@@ -652,35 +767,93 @@ vector<AugmentingPath> algPhase(
 
     matching->resetLabels();
 
+    // Memory accounting - the structures are measured twice a pass bundle, which takes time linear in their size.
+    bool account_memory = config.memory_budget != nullptr || config.metrics != nullptr;
+    MemoryUsage phase_peak_memory;
+    // Set when the last pass bundle ended over the memory limit, holding back the growth of the structures.
+    bool hold_structures = false;
+
     for (int pass_bundle = 0; pass_bundle < pass_bundles_max; pass_bundle++) {
+        // Anytime mode - ending the phase early if the budget can't afford another pass bundle. The augmenting paths
+        // found so far are disjoint, so can still be applied.
+        if (config.budget != nullptr && config.budget->isExhausted(stream, getPassesPerPassBundle(config))) break;
+
         // Used to count the number of operations completed in a pass bundle, part of the Phase Skip optimisation
         int operations_completed = 0;
 
-        if (config.progress_report >= PASS_BUNDLE) std::cout << "Pass bundle: " << pass_bundle << "/" << pass_bundles_max << std::endl;
+        if (config.progress_report >= PASS_BUNDLE) std::cout << "Pass bundle: " << pass_bundle << "/" << pass_bundles_max << '\n';
+        if (config.trace_log != nullptr) config.trace_log->record(TRACE_PASS_BUNDLE_BEGIN, pass_bundle);
+        if (config.metrics != nullptr) config.metrics->beginPassBundle(pass_bundle, stream->number_of_passes);
 
         // Resetting any free node strucures whenever required.
         for (FreeNodeStructure* free_node_struct : available_free_nodes.free_node_structures) {
-            if (free_node_struct->vertex_to_graph_node.size() >= path_limit) free_node_struct->on_hold = true;
+            if (hold_structures || free_node_struct->vertex_to_graph_node.size() >= path_limit) free_node_struct->on_hold = true;
             else free_node_struct->on_hold = false;
             free_node_struct->modified = false;
         }
+        if (hold_structures) {
+            config.memory_budget->held_pass_bundles += 1;
+            if (config.progress_report >= PASS_BUNDLE) std::cout << "MEMORY: Over the memory limit, holding the structures for this pass bundle." << '\n';
+        }
 
         // Attempts to increase the active path of each free node structure in a single pass over the edge stream.
-        extendActivePath(stream, matching, &available_free_nodes, &disjoint_augmenting_paths, config, &operations_completed);
+        extendActivePath(stream, matching, &available_free_nodes, &disjoint_augmenting_paths, config, &operations_completed, ! hold_structures);
+
+        // The structures are largest once extended, limiting how many edges the contraction pass can buffer.
+        long edge_buffer_limit = -1;
+        if (account_memory) {
+            MemoryUsage usage = getMemoryUsage(&available_free_nodes, matching);
+            recordMemoryUsage(usage, config, &phase_peak_memory);
+            if (config.memory_budget != nullptr) edge_buffer_limit = config.memory_budget->getEdgeBufferLimit(usage);
+        }
+
         // Contracts any blossoms in free node structures and checks for any augmenting paths between them.
-        contractAndAugment(stream, &available_free_nodes, &disjoint_augmenting_paths, matching, config, &operations_completed);
+        MemoryUsage edge_buffer_usage;
+        edge_buffer_usage.edge_buffer = contractAndAugment(
+            stream, &available_free_nodes, &disjoint_augmenting_paths, matching, config, &operations_completed, edge_buffer_limit
+        );
         // Backtracks any structures which have not be used.
         backtrackStuckStructures(&available_free_nodes, config, &operations_completed);
 
+        bool over_memory_limit = false;
+        if (account_memory) {
+            recordMemoryUsage(edge_buffer_usage, config, &phase_peak_memory);
+            MemoryUsage usage = getMemoryUsage(&available_free_nodes, matching);
+            recordMemoryUsage(usage, config, &phase_peak_memory);
+            over_memory_limit = config.memory_budget != nullptr && config.memory_budget->isOverLimit(usage);
+        }
+
+        if (config.trace_log != nullptr) config.trace_log->record(TRACE_PASS_BUNDLE_END, pass_bundle);
+        if (config.metrics != nullptr) config.metrics->endPassBundle(&available_free_nodes, stream->number_of_passes);
+
         // Phase Skip optimisation - If we have not completed any overtake, contract, augment or backtrack operations,
         // skip the remaining pass bundles of the current phase.
         if (config.optimisation_level >= PHASE_SKIP && operations_completed == 0) {
-            if (config.progress_report >= PASS_BUNDLE) std::cout << "PHASE SKIP: No operations completed in the current pass bundle, skipping the remainder of the phase." << std::endl;
+            if (config.progress_report >= PASS_BUNDLE) std::cout << "PHASE SKIP: No operations completed in the current pass bundle, skipping the remainder of the phase." << '\n';
+            if (config.trace_log != nullptr) config.trace_log->record(TRACE_PHASE_SKIP, pass_bundle);
             break;
         }
 
+        // Memory budget - if holding the structures for a pass bundle didn't bring the run back under the memory limit,
+        // the phase is ended so its structures are freed. The augmenting paths found so far are disjoint, so can still
+        // be applied.
+        if (over_memory_limit && hold_structures) {
+            config.memory_budget->phases_ended_early += 1;
+            if (config.progress_report >= PHASE) std::cout << "MEMORY: Still over the memory limit, ending the phase early." << '\n';
+            break;
+        }
+        hold_structures = over_memory_limit;
     }
 
+    if (account_memory && config.progress_report >= PHASE) {
+        std::cout << "Phase peak memory: " << phase_peak_memory.getTotal() << " bytes (structures " << phase_peak_memory.structures;
+        std::cout << ", blossoms " << phase_peak_memory.blossoms << ", edge buffer " << phase_peak_memory.edge_buffer;
+        std::cout << ", matching " << phase_peak_memory.matching << ")" << '\n';
+    }
+
+    // Freeing the free node structures, which are rebuilt in the next phase.
+    available_free_nodes.deleteStructures();
+
     return disjoint_augmenting_paths;
 }
 
@@ -707,89 +880,372 @@ Matching get2ApproximateMatching(
     return matching;
 }
 
-Matching getMMSSApproxMaximumMatching(
+Matching getInitialMatching(
+    Stream* stream,
+    Config config
+) {
+    /* Finds the matching the MMSS algorithm starts from, using the initialiser selected in the config. */
+    if (config.metrics != nullptr) config.metrics->beginStage(stream->number_of_passes);
+    int initial_passes = stream->number_of_passes;
+
+    Matching matching;
+    if (config.initial_matching == DEGREE_AWARE_GREEDY) matching = getDegreeAwareGreedyMatching(stream);
+    else if (config.initial_matching == KARP_SIPSER) matching = getKarpSipserMatching(stream);
+    else matching = get2ApproximateMatching(stream);
+
+    if (config.metrics != nullptr) config.metrics->endStage("initial_matching", stream->number_of_passes, matching.matched_edges.size());
+    if (config.progress_report >= SCALE) {
+        std::cout << "Initial matching size: " << matching.matched_edges.size() << " using ";
+        std::cout << stream->number_of_passes - initial_passes << " passes" << '\n';
+    }
+
+    if (config.length_three_augmentation_rounds > 0) {
+        if (config.metrics != nullptr) config.metrics->beginStage(stream->number_of_passes);
+        initial_passes = stream->number_of_passes;
+
+        long augmentations = augmentLengthThreePaths(stream, &matching, config.length_three_augmentation_rounds);
+
+        if (config.metrics != nullptr) config.metrics->endStage("length_three_augmentation", stream->number_of_passes, matching.matched_edges.size());
+        if (config.progress_report >= SCALE) {
+            std::cout << "Length 3 augmentations: " << augmentations << " using " << stream->number_of_passes - initial_passes;
+            std::cout << " passes, matching size: " << matching.matched_edges.size() << '\n';
+        }
+    }
+
+    return matching;
+}
+
+Matching getWarmStartMatching(
+    Stream* stream,
+    Matching* saved_matching
+) {
+    /* Validates a previously saved matching against the current edge stream in a first pass, dropping any saved edges
+       which no longer exist. A second pass then greedily matches the vertices left free, including those whose saved
+       edge was dropped, so the saved edges take priority but the result is still maximal. */
+    Matching matching;
+
+    Edge edge = stream->readStream();
+    // edges are only -1 if we have reached the end of the stream.
+    while (edge.first != -1) {
+        // Both arcs of each edge are streamed, so the edge may already have been added.
+        if (saved_matching->isInMatching(edge) && ! matching.isVertexUsedInMatching(edge.first)) matching.addEdge(edge);
+        // Reading next edge
+        edge = stream->readStream();
+    }
+
+    edge = stream->readStream();
+    while (edge.first != -1) {
+        if (
+            edge.first != edge.second &&
+            ! matching.isVertexUsedInMatching(edge.first) &&
+            ! matching.isVertexUsedInMatching(edge.second)
+        ) {
+            matching.addEdge(edge);
+        }
+        // Reading next edge
+        edge = stream->readStream();
+    }
+
+    return matching;
+}
+
+bool isMatchingCertified(
     Stream* stream,
+    Matching* matching,
     float epsilon,
-    int progress_report = 3,
-    int optimisation_level = 3
+    Config config
 ) {
-    // Setting up the config structure.
-    Config config;
-    if (progress_report < NO_OUTPUT) config.progress_report = NO_OUTPUT;
-    else if (progress_report > VERBOSE) config.progress_report = VERBOSE;
-    else config.progress_report = static_cast<ProgressReport>(progress_report);
+    /* Uses a single pass to compute an upper bound on the maximum matching size, showing whether the current matching
+       is already good enough to stop. In anytime mode this is when the matching meets the target ratio of the budget,
+       and with the Algorithm Skip optimisation when the matching is within the (1 - epsilon) guarantee of the
+       algorithm, as the remaining scales can then only improve on an answer which is already acceptable. */
+    bool target_ratio_set = config.budget != nullptr && config.budget->target_ratio >= 0;
+    bool algorithm_skip = config.optimisation_level >= ALG_SKIP;
+    if (! target_ratio_set && ! algorithm_skip) return false;
+    // The bound isn't computed if the budget can't afford the extra pass.
+    if (config.budget != nullptr && config.budget->isExhausted(stream, 1)) return false;
+
+    long upper_bound = getMatchingUpperBound(stream, matching);
+    long matching_size = matching->matched_edges.size();
+    if (config.progress_report >= SCALE) {
+        std::cout << "Upper bound: " << upper_bound << " Matching size: " << matching_size << '\n';
+    }
 
-    if (optimisation_level < NO_OUTPUT) config.optimisation_level = NO_OPTIMISATION;
-    else if (optimisation_level > PHASE_SKIP) config.optimisation_level = PHASE_SKIP;
-    else config.optimisation_level = static_cast<OptimisationLevel>(optimisation_level);
+    if (target_ratio_set && config.budget->isTargetReached(matching_size, upper_bound)) {
+        if (config.progress_report >= SCALE) std::cout << "ANYTIME: Target ratio reached, stopping early." << '\n';
+        return true;
+    }
 
-    // Greedy matching, giving a 2 approximation
-    Matching matching = get2ApproximateMatching(stream);
+    // Algorithm Skip optimisation - if the upper bound shows the matching is already a (1 - epsilon) approximation, the
+    // remaining scales are skipped.
+    if (algorithm_skip && matching_size >= (1 - epsilon) * upper_bound) {
+        if (config.progress_report >= SCALE) std::cout << "ALG SKIP: Matching is within 1 - epsilon of the upper bound, skipping the remaining scales." << '\n';
+        if (config.trace_log != nullptr) config.trace_log->record(TRACE_ALG_SKIP, static_cast<int>(upper_bound));
+        return true;
+    }
 
-    // Outputting relevant information about the initial matching if required.
-    if (config.progress_report >= SCALE) std::cout << "2 approximation size: " << matching.matched_edges.size() << std::endl;
-    if (config.progress_report >= VERBOSE) std::cout << matching << std::endl;
+    return false;
+}
+
+bool finishWithExactSearch(
+    Stream* stream,
+    Matching* matching,
+    float epsilon,
+    Config config
+) {
+    /* Collects the edges near the free vertices and solves them exactly in memory, replacing the remaining scales and
+       their passes. The subgraph reaches ceil(1 / epsilon) - 1 edges from the free vertices, so afterwards there is no
+       augmenting path of length below 2 / epsilon and the matching keeps the (1 - epsilon) guarantee of the algorithm.
+       If the subgraph holds every component with a free vertex the matching is maximum. Returns false, having only
+       spent the passes, if the subgraph is over the edge limit. */
+    int distance = max(1, static_cast<int>(ceil(1 / epsilon)) - 1);
+    if (config.budget != nullptr && config.budget->isExhausted(stream, distance + 1)) return false;
+    if (config.metrics != nullptr) config.metrics->beginStage(stream->number_of_passes);
+
+    vector<Edge> residual_edges;
+    bool saturated;
+    bool collected = getResidualGraph(stream, matching, distance, config.exact_finish_edge_limit, &residual_edges, &saturated);
+    if (!collected) {
+        if (config.progress_report >= SCALE) std::cout << "EXACT FINISH: Too many edges near the free vertices, continuing." << '\n';
+        if (config.metrics != nullptr) config.metrics->endStage("exact_finish", stream->number_of_passes, matching->matched_edges.size());
+        return false;
+    }
+
+    // Every matched edge with a vertex in the subgraph is inside it, so its matching replaces theirs.
+    ExactMatchingSolver solver;
+    Matching residual_matching = solver.solve(residual_edges, matching);
+    long size_before = matching->matched_edges.size();
+    for (Edge edge : residual_edges) {
+        if (matching->isInMatching(edge)) matching->removeEdgeAndItsVertices(edge);
+    }
+    for (Edge edge : residual_matching.matched_edges) {
+        matching->addEdge(edge);
+    }
+    matching->verifyMatching(config.progress_report >= PHASE);
+
+    if (config.progress_report >= SCALE) {
+        std::cout << "EXACT FINISH: " << residual_edges.size() << " edges near the free vertices solved in memory";
+        std::cout << (saturated ? " (maximum)" : "") << ", matching size " << size_before << " -> " << matching->matched_edges.size() << '\n';
+    }
+    if (config.trace_log != nullptr) config.trace_log->record(TRACE_EXACT_FINISH, static_cast<int>(residual_edges.size()));
+    if (config.metrics != nullptr) config.metrics->endStage("exact_finish", stream->number_of_passes, matching->matched_edges.size());
+    return true;
+}
+
+void improveMatching(
+    Stream* stream,
+    Matching* matching,
+    float epsilon,
+    Config config,
+    int first_scale_index,
+    int first_phase
+) {
+    /* Runs the scales of the MMSS algorithm on an existing matching, starting from the given scale and phase. */
+
+    if (config.graph_type == DETECT_BIPARTITE) {
+        config.graph_type = isStreamBipartite(stream) ? BIPARTITE_GRAPH : GENERAL_GRAPH;
+        if (config.progress_report >= SCALE) {
+            std::cout << "Graph is " << (config.graph_type == BIPARTITE_GRAPH ? "bipartite" : "not bipartite") << '\n';
+        }
+    }
+
+    // Set once the budget has been exhausted, ending the run with the matching found so far.
+    bool budget_exhausted = false;
+
+    /* An exact finish over the edge limit is only retried once the matching has grown, and once the passes since the
+       last attempt are at least twice those spent on attempts so far, so they take at most a third of the run. */
+    bool finished_exactly = false;
+    long exact_finish_failed_size = -1;
+    int exact_finish_passes_spent = 0;
+    int exact_finish_last_pass = stream->number_of_passes;
 
     // Iterating through each scale up to the limit.
     float scale_limit = (epsilon * epsilon) / 64;
-    for (float scale = 0.5f; scale >= scale_limit; scale = scale * 0.5f) {
-        if (config.progress_report >= SCALE) std::cout << "Scale change: " << scale << "/" << scale_limit << std::endl;
-
-        // TODO: TEMP
-        if (scale <= 0.00195312) config.progress_report = VERBOSE;
+    int scale_index = first_scale_index;
+    for (float scale = ldexp(0.5f, -first_scale_index); scale >= scale_limit; scale = scale * 0.5f, scale_index++) {
+        if (config.progress_report >= SCALE) std::cout << "Scale change: " << scale << "/" << scale_limit << '\n';
+        if (config.trace_log != nullptr) config.trace_log->record(TRACE_SCALE_BEGIN, scale_index);
+        if (config.metrics != nullptr) config.metrics->beginStage(stream->number_of_passes);
 
         // Iterating through each phase in the scale.
         float phase_limit = 144.f / (scale * epsilon);
-        for (float phase = 1; phase <= phase_limit; phase++) {
-            if (config.progress_report >= PHASE) std::cout << "Scale: " << scale << "/" << scale_limit << " Phase: " << phase << "/" << phase_limit << std::endl;
+        float starting_phase = (scale_index == first_scale_index) ? static_cast<float>(first_phase) : 1;
+        for (float phase = starting_phase; phase <= phase_limit; phase++) {
+            if (config.progress_report >= PHASE) std::cout << "Scale: " << scale << "/" << scale_limit << " Phase: " << phase << "/" << phase_limit << '\n';
+            if (config.trace_log != nullptr) config.trace_log->record(TRACE_PHASE_BEGIN, static_cast<int>(phase));
+            if (config.metrics != nullptr) config.metrics->beginPhase(scale_index, scale, static_cast<int>(phase));
 
             // Running a single phase of the algorithm to find disjoint augmenting paths.
-            vector<AugmentingPath> disjoint_augmenting_paths = algPhase(stream, &matching, epsilon, scale, config);
+            vector<AugmentingPath> disjoint_augmenting_paths = algPhase(stream, matching, epsilon, scale, config);
 
             // Outputting relevant information about the augmenting paths found if required
             if (config.progress_report >= VERBOSE && ! disjoint_augmenting_paths.empty()) {
-                std::cout << "Augmenting paths found:" << std::endl;
+                std::cout << "Augmenting paths found:" << '\n';
                 for (AugmentingPath path : disjoint_augmenting_paths) {
-                    std::cout << "Path: " << std::endl;
+                    std::cout << "Path: " << '\n';
                     std::cout << "\tTo match: ";
                     for (Edge edge : path.first) {
                         std::cout << edge.first << "->" << edge.second << " ";
                     }
-                    std::cout << std::endl;
+                    std::cout << '\n';
                     std::cout << "\tTo unmatch: ";
                     for (Edge edge : path.second) {
                         std::cout << edge.first << "->" << edge.second << " ";
                     }
-                    std::cout << std::endl;
+                    std::cout << '\n';
                 }
             }
 
+            // The phase ends early if the budget ran out part way through it.
+            budget_exhausted = config.budget != nullptr && config.budget->termination_reason != COMPLETED;
+
             // Scale Skip optimisation - if we find no disjoint augmenting paths after a phase, we skip the current scale.
-            if (config.optimisation_level >= SCALE_SKIP && disjoint_augmenting_paths.empty()) {
-                if (config.progress_report >= SCALE) std::cout << "SCALE SKIP: No augmenting paths found in phase, skipping the remainder of the scale." << std::endl;
+            if (config.optimisation_level >= SCALE_SKIP && disjoint_augmenting_paths.empty() && ! budget_exhausted) {
+                if (config.progress_report >= SCALE) std::cout << "SCALE SKIP: No augmenting paths found in phase, skipping the remainder of the scale." << '\n';
+                if (config.trace_log != nullptr) {
+                    config.trace_log->record(TRACE_SCALE_SKIP, static_cast<int>(phase));
+                    config.trace_log->record(TRACE_PHASE_END, static_cast<int>(phase));
+                }
                 break;
             }
 
             // Augmenting the current matching with the augmenting paths found.
-            matching.augmentMatching(&disjoint_augmenting_paths);
+            matching->augmentMatching(&disjoint_augmenting_paths);
             // Checking the matching is valid
-            matching.verifyMatching();
+            matching->verifyMatching(config.progress_report >= PHASE);
+
+            if (config.trace_log != nullptr) config.trace_log->record(TRACE_PHASE_END, static_cast<int>(phase));
+
+            // Portfolio runs - continuing from the largest matching found by any instance so far.
+            if (config.shared_best != nullptr) config.shared_best->exchange(matching);
+
+            // Saving the position of the run, always saving when stopping early so the run can be resumed. A phase cut
+            // short by the budget is run again from the start on resuming.
+            if (config.checkpoint != nullptr && (budget_exhausted || config.checkpoint->isDue())) {
+                int next_phase = budget_exhausted ? static_cast<int>(phase) : static_cast<int>(phase) + 1;
+                config.checkpoint->write(matching, epsilon, scale_index, next_phase, stream->number_of_passes);
+                if (config.progress_report >= PHASE) std::cout << "Checkpoint written to " << config.checkpoint->file_name << '\n';
+            }
+
+            if (budget_exhausted) break;
+
+            // Exact finish - once the edges near the free vertices fit in memory, the remaining phases and scales are
+            // replaced by an exact search.
+            bool exact_finish_due = config.exact_finish_edge_limit >= 0;
+            exact_finish_due = exact_finish_due && static_cast<long>(matching->matched_edges.size()) > exact_finish_failed_size;
+            exact_finish_due = exact_finish_due && stream->number_of_passes - exact_finish_last_pass >= 2 * exact_finish_passes_spent;
+            if (exact_finish_due) {
+                int passes_before = stream->number_of_passes;
+                finished_exactly = finishWithExactSearch(stream, matching, epsilon, config);
+                if (finished_exactly) break;
+
+                exact_finish_failed_size = matching->matched_edges.size();
+                exact_finish_passes_spent += stream->number_of_passes - passes_before;
+                exact_finish_last_pass = stream->number_of_passes;
+            }
+        }
+
+        if (config.trace_log != nullptr) config.trace_log->record(TRACE_SCALE_END, scale_index);
+        if (config.metrics != nullptr) {
+            config.metrics->endStage("scale_" + to_string(scale_index), stream->number_of_passes, matching->matched_edges.size());
+        }
+
+        if (budget_exhausted) {
+            if (config.progress_report >= SCALE) {
+                std::cout << "ANYTIME: Stopping early, termination reason " << config.budget->termination_reason << '\n';
+            }
+            break;
         }
+        if (finished_exactly) break;
+        // There is nothing left to skip after the last scale.
+        if (scale * 0.5f >= scale_limit && isMatchingCertified(stream, matching, epsilon, config)) break;
+    }
+}
+
+Matching getMMSSApproxMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Config config
+) {
+    if (config.budget != nullptr) config.budget->start(stream);
+
+    // Maximal initial matching, giving a 2 approximation
+    Matching matching = getInitialMatching(stream, config);
+
+    // Outputting relevant information about the initial matching if required.
+    if (config.progress_report >= VERBOSE) std::cout << matching << '\n';
+
+    if (isMatchingCertified(stream, &matching, epsilon, config)) return matching;
+
+    improveMatching(stream, &matching, epsilon, config);
+
+    return matching;
+}
+
+Matching warmStartMMSSApproxMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Matching* saved_matching,
+    int first_scale_index,
+    Config config
+) {
+    /* Starts the algorithm from a previously saved matching rather than a greedy matching. When the graph has changed
+       little since the matching was saved, the early (coarse) scales can be skipped by starting at a later scale. */
+    if (config.budget != nullptr) config.budget->start(stream);
+
+    if (config.metrics != nullptr) config.metrics->beginStage(stream->number_of_passes);
+    Matching matching = getWarmStartMatching(stream, saved_matching);
+    if (config.metrics != nullptr) config.metrics->endStage("warm_start", stream->number_of_passes, matching.matched_edges.size());
+
+    if (config.progress_report >= SCALE) {
+        std::cout << "Warm start size: " << matching.matched_edges.size() << " from " << saved_matching->matched_edges.size();
+        std::cout << " saved edges" << '\n';
     }
+    if (config.progress_report >= VERBOSE) std::cout << matching << '\n';
+
+    if (isMatchingCertified(stream, &matching, epsilon, config)) return matching;
+
+    improveMatching(stream, &matching, epsilon, config, first_scale_index);
 
     return matching;
 }
 
-int main() {
+Matching resumeMMSSApproxMaximumMatching(
+    Stream* stream,
+    CheckpointState* state,
+    Config config
+) {
+    /* Continues a run from the phase recorded in a checkpoint, with the stream's pass count restored so that the total
+       number of passes is reported as if the run had never stopped. */
+    stream->number_of_passes = state->number_of_passes;
+    if (config.budget != nullptr) config.budget->start(stream);
+
+    Matching matching = state->matching;
+    if (config.progress_report >= SCALE) {
+        std::cout << "Resuming from scale " << state->scale_index << " phase " << state->phase << " with matching size ";
+        std::cout << matching.matched_edges.size() << '\n';
+    }
 
-    //Stream* stream = new StreamFromFile("example.txt");
-    Stream* stream = new StreamFromMemory("test_graph.txt");
+    improveMatching(stream, &matching, state->epsilon, config, state->scale_index, state->phase);
 
-    Matching matching = getMMSSApproxMaximumMatching(stream, 0.25, 3, 3);
-    std::cout << matching << std::endl;
-    std::cout << "Total number of passes: " << stream->number_of_passes << std::endl;
+    return matching;
+}
 
-    delete stream;
+Matching getMMSSApproxMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    int progress_report,
+    int optimisation_level
+) {
+    // Setting up the config structure.
+    Config config;
+    if (progress_report < NO_OUTPUT) config.progress_report = NO_OUTPUT;
+    else if (progress_report > VERBOSE) config.progress_report = VERBOSE;
+    else config.progress_report = static_cast<ProgressReport>(progress_report);
+
+    if (optimisation_level < NO_OUTPUT) config.optimisation_level = NO_OPTIMISATION;
+    else if (optimisation_level > PHASE_SKIP) config.optimisation_level = PHASE_SKIP;
+    else config.optimisation_level = static_cast<OptimisationLevel>(optimisation_level);
 
-    return 0;
+    return getMMSSApproxMaximumMatching(stream, epsilon, config);
 }
@@ -0,0 +1,70 @@
+#ifndef MAXMATCHING_H
+#define MAXMATCHING_H
+
+#include "types.h"
+
+#include "Checkpoint/Checkpoint.h"
+#include "Stream/Stream.h"
+#include "Structures/Matching.h"
+
+using namespace std;
+
+vector<AugmentingPath> algPhase(
+    Stream* stream,
+    Matching* matching,
+    float epsilon,
+    float scale,
+    Config config
+);
+
+Matching get2ApproximateMatching(
+    Stream* stream
+);
+
+Matching getMMSSApproxMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Config config
+);
+
+Matching getInitialMatching(
+    Stream* stream,
+    Config config
+);
+
+Matching getWarmStartMatching(
+    Stream* stream,
+    Matching* saved_matching
+);
+
+Matching warmStartMMSSApproxMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    Matching* saved_matching,
+    int first_scale_index,
+    Config config
+);
+
+Matching resumeMMSSApproxMaximumMatching(
+    Stream* stream,
+    CheckpointState* state,
+    Config config
+);
+
+void improveMatching(
+    Stream* stream,
+    Matching* matching,
+    float epsilon,
+    Config config,
+    int first_scale_index = 0,
+    int first_phase = 1
+);
+
+Matching getMMSSApproxMaximumMatching(
+    Stream* stream,
+    float epsilon,
+    int progress_report = 3,
+    int optimisation_level = 3
+);
+
+#endif //MAXMATCHING_H
@@ -5,6 +5,7 @@
 #include <boost/container_hash/hash.hpp>
 
 #include <set>
+#include <vector>
 
 using namespace std;
 
@@ -27,9 +28,47 @@ enum OptimisationLevel {
     PHASE_SKIP = 3, // Enables the Phase Skip optimisation
 };
 
+enum InitialMatchingType {
+    GREEDY = 0, // First fit greedy matching in a single pass
+    DEGREE_AWARE_GREEDY = 1, // Greedy matching of low degree vertices first, after a degree counting pass
+    KARP_SIPSER = 2, // Streaming Karp-Sipser with a bounded edge buffer, after a degree counting pass
+};
+
+enum GraphType {
+    GENERAL_GRAPH = 0, // No assumptions are made about the graph
+    DETECT_BIPARTITE = 1, // A single pass checks whether the graph is bipartite before the first scale
+    BIPARTITE_GRAPH = 2, // The graph is bipartite, so blossoms never form and the contraction pass is skipped
+};
+
+class Checkpoint;
+class MemoryBudget;
+class Metrics;
+class RunBudget;
+class SharedBestMatching;
+class TraceLog;
+
 struct Config {
-    ProgressReport progress_report;
-    OptimisationLevel optimisation_level;
+    ProgressReport progress_report = NO_OUTPUT;
+    OptimisationLevel optimisation_level = PHASE_SKIP;
+    // Algorithm used to find the initial matching, which is then improved by rounds of length 3 augmentations.
+    InitialMatchingType initial_matching = GREEDY;
+    int length_three_augmentation_rounds = 0;
+    GraphType graph_type = GENERAL_GRAPH;
+    // If at least 0, the run is finished by an exact in-memory search at the end of a phase, once the edges near the
+    // free vertices number at most this many.
+    long exact_finish_edge_limit = -1;
+    // If set, every operation and scale/phase/pass bundle boundary is recorded to this binary log.
+    TraceLog* trace_log = nullptr;
+    // If set, per pass bundle counters and per stage timings are collected here.
+    Metrics* metrics = nullptr;
+    // If set, the run stops early when a pass, time or quality limit is reached, returning the matching so far.
+    RunBudget* budget = nullptr;
+    // If set, the matching and position of the run are saved at phase boundaries once the checkpoint is due.
+    Checkpoint* checkpoint = nullptr;
+    // If set, the matching is exchanged with the largest matching of a portfolio run at the end of every phase.
+    SharedBestMatching* shared_best = nullptr;
+    // If set, the peak memory used by the run is recorded, and kept within max_bytes by holding back structures.
+    MemoryBudget* memory_budget = nullptr;
 };
 
 #endif //TYPES_H